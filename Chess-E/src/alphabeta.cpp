@@ -1,61 +1,183 @@
 #include "alphabeta.h"
-#include <limits>
+#include "see.h"
 #include <algorithm>
+#include <cstdlib>
 
-AlphaBetaSearch::AlphaBetaSearch() :
-    evaluationFunction(),
-    moveGenerator(),
-    transpositionTable(),
+AlphaBetaSearch::AlphaBetaSearch(TranspositionTable& table, const SearchPolicy& policy) :
+    policy(policy),
+    transpositionTable(table),
     quiescenceSearch(),
-    moveOrdering()
+    moveOrdering(),
+    searchExtensions(),
+    stopSignal(nullptr),
+    rootBestMove(),
+    nodes(0)
 {}
 
+int AlphaBetaSearch::alphaBeta(Board& board, int depth, int alpha, int beta, int ply) {
+    return negamax<PV_NODE>(board, depth, alpha, beta, ply, false);
+}
+
+int AlphaBetaSearch::searchRoot(Board& board, int depth, int previousScore, Move& bestMove) {
+    const int infinity = Evaluation::INFINITY_VALUE;
+    rootBestMove = Move();
+    if (!policy.aspirationWindows || depth < 4 || previousScore == Evaluation::VALUE_UNKNOWN ||
+        std::abs(previousScore) >= Evaluation::MATE_IN_MAX_PLY) {
+        int score = alphaBeta(board, depth, -infinity, infinity);
+        bestMove = rootBestMove;
+        return score;
+    }
+
+    // Only the side that failed is widened, by a window that doubles on
+    // every failure, so a score that keeps moving is bracketed quickly.
+    int window = ASPIRATION_WINDOW;
+    int alpha = previousScore - window;
+    int beta = previousScore + window;
+    while (true) {
+        int score = alphaBeta(board, depth, alpha, beta);
+        if (stopped()) {
+            return score;
+        }
+        if (score <= alpha && alpha > -infinity) {
+            alpha = std::max(-infinity, score - window);
+        } else if (score >= beta && beta < infinity) {
+            beta = std::min(infinity, score + window);
+        } else {
+            bestMove = rootBestMove;
+            return score;
+        }
+        window *= 2;
+    }
+}
 
-int AlphaBetaSearch::alphaBeta(Board& board, int depth, int alpha, int beta) {
-    if (depth == 0) {
-        return quiescenceSearch.quiescence(board, alpha, beta);
+// PV nodes are the ones that can still end up on the principal variation:
+// they get a full window, and their table hits are searched anyway so the
+// line stays intact. Every other node is searched with a zero window and is
+// where null move pruning applies. Without the principalVariation policy all
+// nodes below the root are NON_PV_NODE with a full window.
+template<AlphaBetaSearch::NodeType Type>
+int AlphaBetaSearch::negamax(Board& board, int depth, int alpha, int beta, int ply, bool allowNullMove) {
+    constexpr bool pvNode = Type == PV_NODE;
+
+    if (stopped()) {
+        return 0;
+    }
+    nodes++;
+    if (depth <= 0 || ply >= Evaluation::MAX_PLY - 1) {
+        return quiescenceSearch.quiescence(board, alpha, beta, ply);
     }
 
-    int ttValue = transpositionTable.probe(board, depth, alpha, beta);
-    if (ttValue != Evaluation::VALUE_UNKNOWN) {
+    Move ttMove;
+    int ttValue = transpositionTable.probe(board, depth, alpha, beta, ply, ttMove);
+    if (ttValue != Evaluation::VALUE_UNKNOWN && !pvNode) {
         return ttValue;
     }
 
-    std::vector<Move> moves = moveGenerator.generateLegalMoves(board);
-    moveOrdering.orderMoves(board, moves);
+    bool inCheck = board.isKingInCheck(board.getTurn());
+
+    // Passing and still failing high means the position is so good that a
+    // real move will almost surely fail high too. Zugzwang is why it is never
+    // tried without pieces to move.
+    if (policy.nullMove && !pvNode && allowNullMove && !inCheck && depth >= 3 && hasNonPawnMaterial(board)) {
+        board.makeNullMove();
+        int nullValue = -negamax<NON_PV_NODE>(board, depth - 1 - NULL_MOVE_REDUCTION, -beta, -beta + 1, ply + 1, false);
+        board.unmakeNullMove();
+        if (nullValue >= beta && !stopped()) {
+            return beta;
+        }
+    }
 
-    int bestValue = std::numeric_limits<int>::min();
-    Move bestMove = Move(-1, -1, -1, -1);
+    MovePicker picker(board, ttMove, ply, moveOrdering);
+    MoveList quietsTried;
 
-    for (const auto& move : moves) {
-        Board nextBoard = board;
-        nextBoard.movePiece(move.startRow, move.startCol, move.endRow, move.endCol);
-        nextBoard.switchTurn();
+    int originalAlpha = alpha;
+    int bestValue = -Evaluation::INFINITY_VALUE;
+    Move bestMove = Move();
+    int moveCount = 0;
 
-        int currentValue = -alphaBeta(nextBoard, depth - 1, -beta, -alpha);
-        if (currentValue > bestValue) {
-            bestValue = currentValue;
+    for (Move move = picker.nextMove(); move.isValid(); move = picker.nextMove()) {
+        moveCount++;
+        // Issued before the extension and SEE work and the move itself, so
+        // the child's bucket is on its way while that runs.
+        transpositionTable.prefetch(board.hashAfter(move));
+        bool quiet = MoveOrdering::isQuiet(board, move);
+        int newDepth = depth - 1;
+        if (policy.extensions && searchExtensions.shouldExtendSearch(board, move, depth)) {
+            newDepth++;
+        }
+        // Late moves are reduced unless they are extended, captures or
+        // promotions that hold up by SEE, or made while in check.
+        bool reducible = policy.lateMoveReduction && moveCount > 2 && depth >= 3 && !inCheck &&
+                         newDepth < depth && (quiet || SEE::evaluate(board, move) < 0);
+
+        board.makeMove(move);
+
+        int value = 0;
+        bool fullDepth = true;
+        if (reducible && !board.isKingInCheck(board.getTurn())) {
+            int reducedDepth = std::max(1, newDepth - reduction(depth, moveCount));
+            int reducedAlpha = policy.principalVariation ? -alpha - 1 : -beta;
+            value = -negamax<NON_PV_NODE>(board, reducedDepth, reducedAlpha, -alpha, ply + 1, true);
+            fullDepth = value > alpha;
+        }
+        if (fullDepth) {
+            if (!policy.principalVariation) {
+                value = -negamax<NON_PV_NODE>(board, newDepth, -beta, -alpha, ply + 1, true);
+            } else if (pvNode && moveCount == 1) {
+                value = -negamax<PV_NODE>(board, newDepth, -beta, -alpha, ply + 1, true);
+            } else {
+                value = -negamax<NON_PV_NODE>(board, newDepth, -alpha - 1, -alpha, ply + 1, true);
+                if (pvNode && value > alpha && value < beta) {
+                    value = -negamax<PV_NODE>(board, newDepth, -beta, -alpha, ply + 1, true);
+                }
+            }
+        }
+        board.unmakeMove();
+        if (stopped()) {
+            return 0;
+        }
+
+        if (value > bestValue) {
+            bestValue = value;
             bestMove = move;
         }
         alpha = std::max(alpha, bestValue);
         if (beta <= alpha) {
+            if (quiet) {
+                moveOrdering.updateQuietStats(board, move, quietsTried, ply, depth);
+            }
             break;
         }
-    }
-
-    if (moves.empty()) {
-        if (board.isKingInCheck(board.getTurn())) {
-            return -Evaluation::CHECKMATE_VALUE - depth; 
-        } else {
-            return 0;
+        if (quiet) {
+            quietsTried.push_back(move);
         }
     }
 
-    transpositionTable.store(board, depth, bestValue, TranspositionTable::EXACT_VALUE, bestMove);
+    if (moveCount == 0) {
+        return inCheck ? -Evaluation::CHECKMATE_VALUE + ply : 0;
+    }
+    if (ply == 0) {
+        rootBestMove = bestMove;
+    }
 
+    transpositionTable.store(board, depth, bestValue, TranspositionTable::boundType(bestValue, originalAlpha, beta),
+                             bestMove, ply);
     return bestValue;
 }
 
+int AlphaBetaSearch::reduction(int depth, int moveCount) {
+    return std::max(1, depth / 4 + moveCount / 5);
+}
+
+bool AlphaBetaSearch::hasNonPawnMaterial(const Board& board) {
+    PieceColor us = board.getTurn();
+    return (board.occupancy(us) & ~board.pieces(us, PAWN) & ~board.pieces(us, KING)) != EMPTY_BB;
+}
+
 const TranspositionTable& AlphaBetaSearch::getTranspositionTable() const {
     return transpositionTable;
-}
\ No newline at end of file
+}
+
+void AlphaBetaSearch::clearHeuristics() {
+    moveOrdering.clear();
+}
@@ -7,19 +7,81 @@
 #include "transposition_table.h"
 #include "quiescence_search.h"
 #include "move_ordering.h"
+#include "move_picker.h"
+#include "search_extensions.h"
+#include <atomic>
+#include <cstdint>
 
+// The techniques the kernel layers on top of plain alpha-beta. All of them
+// work in the same tree, so any subset can be switched off to measure what
+// it contributes; SearchPolicy::plain() is textbook alpha-beta.
+struct SearchPolicy {
+    bool principalVariation = true;  // zero-window search after the first move
+    bool nullMove = true;
+    bool lateMoveReduction = true;
+    bool extensions = false;         // off: extending every capture explodes tactical trees
+    bool aspirationWindows = true;   // root only, see searchRoot
+
+    static SearchPolicy plain() {
+        SearchPolicy policy;
+        policy.principalVariation = policy.nullMove = policy.lateMoveReduction = false;
+        policy.extensions = policy.aspirationWindows = false;
+        return policy;
+    }
+};
+
+// One negamax kernel for the whole engine. The transposition table is
+// shared with whoever else searches; the move ordering heuristics belong to
+// this instance, so each search thread owns one kernel.
 class AlphaBetaSearch {
 public:
-    AlphaBetaSearch();
-    int alphaBeta(Board& board, int depth, int alpha, int beta);
+    explicit AlphaBetaSearch(TranspositionTable& table, const SearchPolicy& policy = SearchPolicy());
+
+    // Searches the position as a PV node with the given window.
+    int alphaBeta(Board& board, int depth, int alpha, int beta, int ply = 0);
+    // One iterative deepening step: a narrow window around the previous
+    // iteration's score, widened on failure, when the policy allows it.
+    // bestMove is the root move of the search that ended inside its window,
+    // taken from this kernel rather than the table other threads write to.
+    int searchRoot(Board& board, int depth, int previousScore, Move& bestMove);
+
     const TranspositionTable& getTranspositionTable() const;
+    const SearchPolicy& getPolicy() const { return policy; }
+    void setPolicy(const SearchPolicy& newPolicy) { policy = newPolicy; }
+    void clearHeuristics();
+
+    // Once the signal is raised every node returns at once without touching
+    // the table, so the interrupted iteration's score must be thrown away.
+    void setStopSignal(const std::atomic<bool>* signal) { stopSignal = signal; }
+    bool stopped() const { return stopSignal && stopSignal->load(std::memory_order_relaxed); }
 
-protected:
-    Evaluation evaluationFunction;
-    MoveGenerator moveGenerator;
-    TranspositionTable transpositionTable;
+    // Main search nodes visited since the last reset, leaves included but
+    // not the quiescence search below them.
+    std::uint64_t getNodes() const { return nodes; }
+    void resetNodes() { nodes = 0; }
+
+    static const int NULL_MOVE_REDUCTION = 2;
+    static const int ASPIRATION_WINDOW = 50;
+
+private:
+    enum NodeType {
+        PV_NODE, NON_PV_NODE
+    };
+
+    SearchPolicy policy;
+    TranspositionTable& transpositionTable;
     QuiescenceSearch quiescenceSearch;
     MoveOrdering moveOrdering;
+    SearchExtensions searchExtensions;
+    const std::atomic<bool>* stopSignal;
+    Move rootBestMove;
+    std::uint64_t nodes;
+
+    template<NodeType Type>
+    int negamax(Board& board, int depth, int alpha, int beta, int ply, bool allowNullMove);
+
+    static int reduction(int depth, int moveCount);
+    static bool hasNonPawnMaterial(const Board& board);
 };
 
-#endif 
\ No newline at end of file
+#endif
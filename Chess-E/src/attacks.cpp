@@ -0,0 +1,282 @@
+#include "attacks.h"
+#include "cpu_features.h"
+
+#if CHESS_X86
+#include <immintrin.h>
+#endif
+
+namespace Attacks {
+
+Bitboard pawnTable[2][64];
+Bitboard knightTable[64];
+Bitboard kingTable[64];
+Magic bishopMagics[64];
+Magic rookMagics[64];
+PextSlot bishopPext[64];
+PextSlot rookPext[64];
+Bitboard betweenTable[64][64];
+Bitboard lineTable[64][64];
+SliderBackend sliderBackend = MAGIC_BACKEND;
+
+namespace {
+
+Bitboard bishopTable[0x1480];
+Bitboard rookTable[0x19000];
+
+Bitboard bishopPextTable[0x1480];
+Bitboard rookPextTable[0x19000];
+
+const int BISHOP_DIRECTIONS[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+const int ROOK_DIRECTIONS[4][2] = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}};
+
+bool onBoard(int row, int col) {
+    return row >= 0 && row < 8 && col >= 0 && col < 8;
+}
+
+Bitboard stepAttacks(int square, const int steps[][2], int count) {
+    Bitboard attacks = EMPTY_BB;
+    for (int i = 0; i < count; ++i) {
+        int r = squareRow(square) + steps[i][0];
+        int c = squareCol(square) + steps[i][1];
+        if (onBoard(r, c)) {
+            attacks |= squareBB(makeSquare(r, c));
+        }
+    }
+    return attacks;
+}
+
+Bitboard slidingAttacks(int square, Bitboard occupied, const int directions[4][2]) {
+    Bitboard attacks = EMPTY_BB;
+    for (int i = 0; i < 4; ++i) {
+        int r = squareRow(square) + directions[i][0];
+        int c = squareCol(square) + directions[i][1];
+        while (onBoard(r, c)) {
+            attacks |= squareBB(makeSquare(r, c));
+            if (occupied & squareBB(makeSquare(r, c))) {
+                break;
+            }
+            r += directions[i][0];
+            c += directions[i][1];
+        }
+    }
+    return attacks;
+}
+
+// xorshift64* generator; fixed seeds keep the magics identical between runs.
+class MagicRandom {
+public:
+    explicit MagicRandom(std::uint64_t seed) : state(seed) {}
+
+    std::uint64_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 2685821657736338717ULL;
+    }
+
+    std::uint64_t sparse() {
+        return next() & next() & next();
+    }
+
+private:
+    std::uint64_t state;
+};
+
+void initMagics(Magic magics[64], Bitboard* table, PextSlot pext[64], Bitboard* pextTable,
+                const int directions[4][2]) {
+    static const std::uint64_t seeds[8] = {728, 10316, 55013, 32803, 12281, 15100, 16645, 255};
+
+    Bitboard occupancy[4096];
+    Bitboard reference[4096];
+    int epoch[4096] = {};
+    int attempt = 0;
+    int size = 0;
+
+    for (int square = 0; square < 64; ++square) {
+        Magic& m = magics[square];
+
+        // Edge squares never block a ray, so they are left out of the mask.
+        Bitboard edges = ((rowBB(0) | rowBB(7)) & ~rowBB(squareRow(square))) |
+                         ((fileBB(0) | fileBB(7)) & ~fileBB(squareCol(square)));
+        m.mask = slidingAttacks(square, EMPTY_BB, directions) & ~edges;
+        m.shift = 64 - popCount(m.mask);
+        m.attacks = (square == 0) ? table : magics[square - 1].attacks + size;
+
+        // Carry-Rippler enumeration of every subset of the mask. Subsets come
+        // out in increasing PEXT order, so the i-th one is PEXT index i.
+        PextSlot& p = pext[square];
+        p.mask = m.mask;
+        p.attacks = pextTable + (m.attacks - table);
+        size = 0;
+        Bitboard subset = EMPTY_BB;
+        do {
+            occupancy[size] = subset;
+            reference[size] = slidingAttacks(square, subset, directions);
+            p.attacks[size] = reference[size];
+            size++;
+            subset = (subset - m.mask) & m.mask;
+        } while (subset);
+
+        MagicRandom rng(seeds[squareRow(square)]);
+        for (int i = 0; i < size;) {
+            do {
+                m.magic = rng.sparse();
+            } while (popCount((m.magic * m.mask) >> 56) < 6);
+
+            ++attempt;
+            for (i = 0; i < size; ++i) {
+                unsigned idx = m.index(occupancy[i]);
+                if (epoch[idx] < attempt) {
+                    epoch[idx] = attempt;
+                    m.attacks[idx] = reference[i];
+                } else if (m.attacks[idx] != reference[i]) {
+                    break;
+                }
+            }
+        }
+    }
+}
+
+#if CHESS_X86
+// Shifts each lane left or right by its own count; a count of 64 or more
+// yields zero, so every lane uses exactly one of the two shifts.
+TARGET_ATTRIBUTE("avx2") inline __m256i shiftLanes(__m256i x, __m256i left, __m256i right) {
+    return _mm256_or_si256(_mm256_sllv_epi64(x, left), _mm256_srlv_epi64(x, right));
+}
+
+// Kogge-Stone occluded fill along four directions in parallel, one per
+// 64-bit lane, followed by a final step onto the first blocker.
+TARGET_ATTRIBUTE("avx2")
+Bitboard koggeStoneFill(int square, Bitboard occupied, const long long left[4], const long long right[4],
+                        const long long notWrap[4]) {
+    __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left));
+    __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right));
+    __m256i mask = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(notWrap));
+
+    __m256i gen = _mm256_set1_epi64x(static_cast<long long>(squareBB(square)));
+    __m256i prop = _mm256_and_si256(_mm256_set1_epi64x(static_cast<long long>(~occupied)), mask);
+
+    gen = _mm256_or_si256(gen, _mm256_and_si256(prop, shiftLanes(gen, l, r)));
+    prop = _mm256_and_si256(prop, shiftLanes(prop, l, r));
+    __m256i l2 = _mm256_add_epi64(l, l);
+    __m256i r2 = _mm256_add_epi64(r, r);
+    gen = _mm256_or_si256(gen, _mm256_and_si256(prop, shiftLanes(gen, l2, r2)));
+    prop = _mm256_and_si256(prop, shiftLanes(prop, l2, r2));
+    gen = _mm256_or_si256(gen, _mm256_and_si256(prop, shiftLanes(gen, _mm256_add_epi64(l2, l2),
+                                                                     _mm256_add_epi64(r2, r2))));
+    __m256i attacks = _mm256_and_si256(shiftLanes(gen, l, r), mask);
+
+    __m128i folded = _mm_or_si128(_mm256_castsi256_si128(attacks), _mm256_extracti128_si256(attacks, 1));
+    return static_cast<Bitboard>(_mm_cvtsi128_si64(folded) | _mm_extract_epi64(folded, 1));
+}
+
+const long long NOT_FILE_A = static_cast<long long>(~FILE_A_BB);
+const long long NOT_FILE_H = static_cast<long long>(~FILE_H_BB);
+const long long ANY_FILE = -1;
+
+// Lanes: south-east, south-west, north-east, north-west.
+const long long BISHOP_LEFT[4] = {9, 7, 64, 64};
+const long long BISHOP_RIGHT[4] = {64, 64, 7, 9};
+const long long BISHOP_NOT_WRAP[4] = {NOT_FILE_A, NOT_FILE_H, NOT_FILE_A, NOT_FILE_H};
+
+// Lanes: south, east, north, west.
+const long long ROOK_LEFT[4] = {8, 1, 64, 64};
+const long long ROOK_RIGHT[4] = {64, 64, 8, 1};
+const long long ROOK_NOT_WRAP[4] = {ANY_FILE, NOT_FILE_A, ANY_FILE, NOT_FILE_H};
+#endif
+
+struct AttackTablesInitializer {
+    AttackTablesInitializer() { init(); }
+} attackTablesInitializer;
+
+}
+
+void init() {
+    static bool initialized = false;
+    if (initialized) return;
+    initialized = true;
+
+    const int knightSteps[8][2] = {{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1}};
+    const int kingSteps[8][2] = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}};
+    const int whitePawnSteps[2][2] = {{-1, -1}, {-1, 1}};
+    const int blackPawnSteps[2][2] = {{1, -1}, {1, 1}};
+
+    for (int square = 0; square < 64; ++square) {
+        knightTable[square] = stepAttacks(square, knightSteps, 8);
+        kingTable[square] = stepAttacks(square, kingSteps, 8);
+        pawnTable[WHITE][square] = stepAttacks(square, whitePawnSteps, 2);
+        pawnTable[BLACK][square] = stepAttacks(square, blackPawnSteps, 2);
+    }
+
+    initMagics(bishopMagics, bishopTable, bishopPext, bishopPextTable, BISHOP_DIRECTIONS);
+    initMagics(rookMagics, rookTable, rookPext, rookPextTable, ROOK_DIRECTIONS);
+
+    for (int from = 0; from < 64; ++from) {
+        for (int to = 0; to < 64; ++to) {
+            if (from == to) continue;
+            if (magicBishopAttacks(from, EMPTY_BB) & squareBB(to)) {
+                lineTable[from][to] = (magicBishopAttacks(from, EMPTY_BB) & magicBishopAttacks(to, EMPTY_BB)) |
+                                      squareBB(from) | squareBB(to);
+                betweenTable[from][to] = magicBishopAttacks(from, squareBB(to)) &
+                                         magicBishopAttacks(to, squareBB(from));
+            } else if (magicRookAttacks(from, EMPTY_BB) & squareBB(to)) {
+                lineTable[from][to] = (magicRookAttacks(from, EMPTY_BB) & magicRookAttacks(to, EMPTY_BB)) |
+                                      squareBB(from) | squareBB(to);
+                betweenTable[from][to] = magicRookAttacks(from, squareBB(to)) &
+                                         magicRookAttacks(to, squareBB(from));
+            }
+        }
+    }
+}
+
+bool backendSupported(SliderBackend backend) {
+    switch (backend) {
+        case MAGIC_BACKEND:       return true;
+        case PEXT_BACKEND:        return CHESS_X86 && cpuFeatures().bmi2;
+        case KOGGE_STONE_BACKEND: return CHESS_X86 && cpuFeatures().avx2;
+        default:                  return false;
+    }
+}
+
+bool setBackend(SliderBackend backend) {
+    if (!backendSupported(backend)) {
+        return false;
+    }
+    sliderBackend = backend;
+    return true;
+}
+
+const char* backendName(SliderBackend backend) {
+    switch (backend) {
+        case MAGIC_BACKEND:       return "magic";
+        case PEXT_BACKEND:        return "pext";
+        case KOGGE_STONE_BACKEND: return "kogge-stone";
+        default:                  return "unknown";
+    }
+}
+
+bool parseBackend(const std::string& name, SliderBackend& backend) {
+    for (int i = 0; i < BACKEND_COUNT; ++i) {
+        if (name == backendName(static_cast<SliderBackend>(i))) {
+            backend = static_cast<SliderBackend>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+#if CHESS_X86
+Bitboard koggeStoneBishopAttacks(int square, Bitboard occupied) {
+    return koggeStoneFill(square, occupied, BISHOP_LEFT, BISHOP_RIGHT, BISHOP_NOT_WRAP);
+}
+
+Bitboard koggeStoneRookAttacks(int square, Bitboard occupied) {
+    return koggeStoneFill(square, occupied, ROOK_LEFT, ROOK_RIGHT, ROOK_NOT_WRAP);
+}
+#else
+// Never selected on other architectures; kept so the dispatch links.
+Bitboard koggeStoneBishopAttacks(int square, Bitboard occupied) { return magicBishopAttacks(square, occupied); }
+Bitboard koggeStoneRookAttacks(int square, Bitboard occupied) { return magicRookAttacks(square, occupied); }
+#endif
+
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "bitboard.h"
+#include "board.h"
+#include "cpu_features.h"
+#include <string>
+
+#if CHESS_X86
+#include <immintrin.h>
+#endif
+
+namespace Attacks {
+
+// Interchangeable ways to compute slider attacks. All of them return
+// identical bitboards; they differ only in speed on a given CPU.
+enum SliderBackend {
+    MAGIC_BACKEND,        // fancy magics, portable
+    PEXT_BACKEND,         // BMI2 PEXT indexes the occupancy directly
+    KOGGE_STONE_BACKEND,  // AVX2 occluded fill of all four rays at once
+    BACKEND_COUNT
+};
+
+// Fancy magic bitboards: the relevant occupancy of a slider is multiplied by
+// a per-square magic and shifted down to a dense index into a shared table.
+struct Magic {
+    Bitboard mask;
+    Bitboard magic;
+    Bitboard* attacks;
+    unsigned shift;
+
+    unsigned index(Bitboard occupied) const {
+        return static_cast<unsigned>(((occupied & mask) * magic) >> shift);
+    }
+};
+
+// PEXT packs the relevant occupancy bits into a dense index, so each square
+// needs exactly as many slots as with magics, only in a different order.
+struct PextSlot {
+    Bitboard mask;
+    Bitboard* attacks;
+};
+
+extern Bitboard pawnTable[2][64];
+extern Bitboard knightTable[64];
+extern Bitboard kingTable[64];
+extern Magic bishopMagics[64];
+extern Magic rookMagics[64];
+extern PextSlot bishopPext[64];
+extern PextSlot rookPext[64];
+extern Bitboard betweenTable[64][64];
+extern Bitboard lineTable[64][64];
+
+extern SliderBackend sliderBackend;
+
+void init();
+
+// Magics are the default: on the CPUs measured so far PEXT only catches up
+// when the whole engine is built for BMI2, so it has to be asked for.
+// setBackend fails for a backend this CPU or build cannot run.
+bool backendSupported(SliderBackend backend);
+bool setBackend(SliderBackend backend);
+const char* backendName(SliderBackend backend);
+bool parseBackend(const std::string& name, SliderBackend& backend);
+
+Bitboard koggeStoneBishopAttacks(int square, Bitboard occupied);
+Bitboard koggeStoneRookAttacks(int square, Bitboard occupied);
+
+inline Bitboard pawnAttacks(PieceColor color, int square) { return pawnTable[color][square]; }
+inline Bitboard knightAttacks(int square) { return knightTable[square]; }
+inline Bitboard kingAttacks(int square) { return kingTable[square]; }
+
+inline Bitboard magicBishopAttacks(int square, Bitboard occupied) {
+    const Magic& m = bishopMagics[square];
+    return m.attacks[m.index(occupied)];
+}
+
+inline Bitboard magicRookAttacks(int square, Bitboard occupied) {
+    const Magic& m = rookMagics[square];
+    return m.attacks[m.index(occupied)];
+}
+
+// Inline like the magic lookups. In a build without BMI2 enabled the
+// compiler still has to call them, since a bmi2 function cannot be inlined
+// into generic code, but the call stays within the translation unit.
+#if CHESS_X86
+TARGET_ATTRIBUTE("bmi2") inline Bitboard pextBishopAttacks(int square, Bitboard occupied) {
+    const PextSlot& p = bishopPext[square];
+    return p.attacks[_pext_u64(occupied, p.mask)];
+}
+
+TARGET_ATTRIBUTE("bmi2") inline Bitboard pextRookAttacks(int square, Bitboard occupied) {
+    const PextSlot& p = rookPext[square];
+    return p.attacks[_pext_u64(occupied, p.mask)];
+}
+#else
+// Never selected on other architectures; kept so the dispatch compiles.
+inline Bitboard pextBishopAttacks(int square, Bitboard occupied) { return magicBishopAttacks(square, occupied); }
+inline Bitboard pextRookAttacks(int square, Bitboard occupied) { return magicRookAttacks(square, occupied); }
+#endif
+
+// The backend never changes during a search, so the switch is a perfectly
+// predicted branch.
+inline Bitboard bishopAttacks(int square, Bitboard occupied) {
+    switch (sliderBackend) {
+        case PEXT_BACKEND:        return pextBishopAttacks(square, occupied);
+        case KOGGE_STONE_BACKEND: return koggeStoneBishopAttacks(square, occupied);
+        default:                  return magicBishopAttacks(square, occupied);
+    }
+}
+
+inline Bitboard rookAttacks(int square, Bitboard occupied) {
+    switch (sliderBackend) {
+        case PEXT_BACKEND:        return pextRookAttacks(square, occupied);
+        case KOGGE_STONE_BACKEND: return koggeStoneRookAttacks(square, occupied);
+        default:                  return magicRookAttacks(square, occupied);
+    }
+}
+
+inline Bitboard queenAttacks(int square, Bitboard occupied) {
+    return bishopAttacks(square, occupied) | rookAttacks(square, occupied);
+}
+
+// Squares strictly between two aligned squares, and the full line through
+// them; both are empty when the squares do not share a rank, file or diagonal.
+inline Bitboard between(int from, int to) { return betweenTable[from][to]; }
+inline Bitboard line(int from, int to) { return lineTable[from][to]; }
+
+inline Bitboard attacksFrom(PieceType type, PieceColor color, int square, Bitboard occupied) {
+    switch (type) {
+        case PAWN:   return pawnAttacks(color, square);
+        case KNIGHT: return knightAttacks(square);
+        case BISHOP: return bishopAttacks(square, occupied);
+        case ROOK:   return rookAttacks(square, occupied);
+        case QUEEN:  return queenAttacks(square, occupied);
+        case KING:   return kingAttacks(square);
+        default:     return EMPTY_BB;
+    }
+}
+
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Squares are numbered row * 8 + col, matching Board::getKingPosition:
+// bit 0 is a8, bit 7 is h8, bit 56 is a1 and bit 63 is h1.
+using Bitboard = std::uint64_t;
+
+constexpr Bitboard EMPTY_BB = 0ULL;
+constexpr Bitboard FULL_BB = ~0ULL;
+
+constexpr Bitboard FILE_A_BB = 0x0101010101010101ULL;
+constexpr Bitboard FILE_H_BB = FILE_A_BB << 7;
+constexpr Bitboard ROW_0_BB = 0xFFULL;
+
+constexpr int makeSquare(int row, int col) { return row * 8 + col; }
+constexpr int squareRow(int square) { return square >> 3; }
+constexpr int squareCol(int square) { return square & 7; }
+
+constexpr Bitboard squareBB(int square) { return 1ULL << square; }
+constexpr Bitboard fileBB(int col) { return FILE_A_BB << col; }
+constexpr Bitboard rowBB(int row) { return ROW_0_BB << (8 * row); }
+
+inline int popCount(Bitboard b) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt64(b));
+#else
+    return __builtin_popcountll(b);
+#endif
+}
+
+inline int lsb(Bitboard b) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, b);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(b);
+#endif
+}
+
+inline int popLsb(Bitboard& b) {
+    int square = lsb(b);
+    b &= b - 1;
+    return square;
+}
+
+inline bool moreThanOne(Bitboard b) {
+    return (b & (b - 1)) != 0;
+}
+
+// Board directions as square offsets. NORTH points towards row 0 (rank 8),
+// so it is White's pawn push.
+enum Direction {
+    NORTH = -8, SOUTH = 8, EAST = 1, WEST = -1,
+    NORTH_EAST = -7, NORTH_WEST = -9, SOUTH_EAST = 9, SOUTH_WEST = 7
+};
+
+// Moves every set bit one step in direction D, dropping bits that would wrap
+// around the a- or h-file.
+template<Direction D>
+constexpr Bitboard shift(Bitboard b) {
+    return D == NORTH      ? b >> 8
+         : D == SOUTH      ? b << 8
+         : D == EAST       ? (b & ~FILE_H_BB) << 1
+         : D == WEST       ? (b & ~FILE_A_BB) >> 1
+         : D == NORTH_EAST ? (b & ~FILE_H_BB) >> 7
+         : D == NORTH_WEST ? (b & ~FILE_A_BB) >> 9
+         : D == SOUTH_EAST ? (b & ~FILE_H_BB) << 9
+         : D == SOUTH_WEST ? (b & ~FILE_A_BB) << 7
+         : EMPTY_BB;
+}
+
+// Smears every bit along its file towards row 0 (north) or row 7 (south) in
+// three doubling steps.
+constexpr Bitboard northFill(Bitboard b) {
+    b |= b >> 8;
+    b |= b >> 16;
+    return b | (b >> 32);
+}
+
+constexpr Bitboard southFill(Bitboard b) {
+    b |= b << 8;
+    b |= b << 16;
+    return b | (b << 32);
+}
+
+constexpr Bitboard fileFill(Bitboard b) {
+    return northFill(b) | southFill(b);
+}
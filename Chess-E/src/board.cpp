@@ -1,34 +1,42 @@
 #include "board.h"
+#include "attacks.h"
+#include "move.h"
+#include "psqt.h"
+#include "zobrist.h"
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
 
-Board::Board() : turn(WHITE) {
-    clearBoard();
-}
+namespace {
 
-Board::Board(const std::string& fen) : turn(WHITE) {
-    loadFen(fen);
+const std::uint8_t EMPTY_CODE = EMPTY | (NONE << 3);
+
+std::uint8_t encodePiece(PieceType type, PieceColor color) {
+    return static_cast<std::uint8_t>(type | (color << 3));
 }
 
-Board::Board(const Board& other) : turn(other.turn) {
-    for (int i = 0; i < 8; ++i) {
-        for (int j = 0; j < 8; ++j) {
-            board[i][j] = other.board[i][j];
-        }
+// Rights lost when a piece leaves or lands on the square.
+int castlingMask(int square) {
+    switch (square) {
+        case 0:  return BLACK_QUEENSIDE;
+        case 4:  return BLACK_KINGSIDE | BLACK_QUEENSIDE;
+        case 7:  return BLACK_KINGSIDE;
+        case 56: return WHITE_QUEENSIDE;
+        case 60: return WHITE_KINGSIDE | WHITE_QUEENSIDE;
+        case 63: return WHITE_KINGSIDE;
+        default: return NO_CASTLING;
     }
 }
 
-Board& Board::operator=(const Board& other) {
-    if (this == &other) {
-        return *this;
-    }
-    turn = other.turn;
-    for (int i = 0; i < 8; ++i) {
-        for (int j = 0; j < 8; ++j) {
-            board[i][j] = other.board[i][j];
-        }
-    }
-    return *this;
 }
 
+Board::Board() : turn(WHITE) {
+    clearBoard();
+}
+
+Board::Board(const std::string& fen) : turn(WHITE) {
+    loadFen(fen);
+}
 
 void Board::initializeStandardSetup() {
     clearBoard();
@@ -54,6 +62,8 @@ void Board::initializeStandardSetup() {
     for (int j = 0; j < 8; ++j) setPieceAt(1, j, Piece(PAWN, BLACK));
 
     turn = WHITE;
+    castlingRights = ALL_CASTLING;
+    hashKey = computeHash();
 }
 
 void Board::loadFen(const std::string& fen) {
@@ -61,7 +71,7 @@ void Board::loadFen(const std::string& fen) {
     int row = 0, col = 0;
     int fenIndex = 0;
 
-    while (row < 8) {
+    while (row < 8 && fenIndex < static_cast<int>(fen.size())) {
         char currentChar = fen[fenIndex++];
         if (isdigit(currentChar)) {
             int emptySquares = currentChar - '0';
@@ -90,13 +100,31 @@ void Board::loadFen(const std::string& fen) {
         }
     }
 
-    if (fen[fenIndex] == 'w') {
-        turn = WHITE;
-    } else if (fen[fenIndex] == 'b') {
-        turn = BLACK;
-    } else {
-        turn = WHITE; 
+    std::istringstream fields(fenIndex < static_cast<int>(fen.size()) ? fen.substr(fenIndex) : "");
+    std::string side, castling, enPassant;
+    fields >> side >> castling >> enPassant >> halfmoveClock >> fullmoveNumber;
+
+    turn = (side == "b") ? BLACK : WHITE;
+
+    for (char c : castling) {
+        switch (c) {
+            case 'K': castlingRights |= WHITE_KINGSIDE;  break;
+            case 'Q': castlingRights |= WHITE_QUEENSIDE; break;
+            case 'k': castlingRights |= BLACK_KINGSIDE;  break;
+            case 'q': castlingRights |= BLACK_QUEENSIDE; break;
+            default: break;
+        }
+    }
+
+    if (enPassant.length() == 2 && enPassant[0] >= 'a' && enPassant[0] <= 'h' &&
+        enPassant[1] >= '1' && enPassant[1] <= '8') {
+        enPassantSquare = makeSquare('8' - enPassant[1], enPassant[0] - 'a');
     }
+
+    if (halfmoveClock < 0) halfmoveClock = 0;
+    if (fullmoveNumber < 1) fullmoveNumber = 1;
+
+    hashKey = computeHash();
 }
 
 std::string Board::toFen() const {
@@ -134,7 +162,26 @@ std::string Board::toFen() const {
     }
     fen += " ";
     fen += (turn == WHITE) ? 'w' : 'b';
-    fen += " - - 0 1"; 
+
+    fen += " ";
+    if (castlingRights == NO_CASTLING) {
+        fen += '-';
+    } else {
+        if (castlingRights & WHITE_KINGSIDE)  fen += 'K';
+        if (castlingRights & WHITE_QUEENSIDE) fen += 'Q';
+        if (castlingRights & BLACK_KINGSIDE)  fen += 'k';
+        if (castlingRights & BLACK_QUEENSIDE) fen += 'q';
+    }
+
+    fen += " ";
+    if (enPassantSquare == NO_SQUARE) {
+        fen += '-';
+    } else {
+        fen += char('a' + squareCol(enPassantSquare));
+        fen += char('8' - squareRow(enPassantSquare));
+    }
+
+    fen += " " + std::to_string(halfmoveClock) + " " + std::to_string(fullmoveNumber);
     return fen;
 }
 
@@ -168,14 +215,20 @@ void Board::printBoard() const {
 
 Piece Board::getPieceAt(int row, int col) const {
     if (row >= 0 && row < 8 && col >= 0 && col < 8) {
-        return board[row][col];
+        std::uint8_t code = mailbox[makeSquare(row, col)];
+        return Piece(static_cast<PieceType>(code & 7), static_cast<PieceColor>(code >> 3));
     }
     return Piece(); 
 }
 
 void Board::setPieceAt(int row, int col, const Piece& piece) {
     if (row >= 0 && row < 8 && col >= 0 && col < 8) {
-        board[row][col] = piece;
+        int square = makeSquare(row, col);
+        editIndex = historySize();
+        removePiece(square);
+        if (!piece.isEmpty() && piece.color != NONE) {
+            putPiece(square, piece.type, piece.color);
+        }
     }
 }
 
@@ -189,138 +242,354 @@ void Board::movePiece(int startRow, int startCol, int endRow, int endCol) {
 }
 
 void Board::clearBoard() {
-    for (int i = 0; i < 8; ++i) {
-        for (int j = 0; j < 8; ++j) {
-            board[i][j] = Piece(); 
+    for (int color = WHITE; color <= BLACK; ++color) {
+        for (int type = PAWN; type <= KING; ++type) {
+            pieceBB[color][type] = EMPTY_BB;
         }
+        colorBB[color] = EMPTY_BB;
     }
+    occupiedBB = EMPTY_BB;
+    for (int square = 0; square < 64; ++square) {
+        mailbox[square] = EMPTY_CODE;
+    }
+    kingSquare[WHITE] = kingSquare[BLACK] = NO_SQUARE;
+    mgScore = egScore = phase = 0;
+    pawnKey = 0;
+
+    castlingRights = NO_CASTLING;
+    enPassantSquare = NO_SQUARE;
+    halfmoveClock = 0;
+    fullmoveNumber = 1;
+    hashKey = (turn == BLACK) ? Zobrist::KEYS.sideToMove : 0;
+    history.clear();
+    editIndex = 0;
 }
 
-PieceColor Board::getTurn() const {
-    return turn;
+void Board::putPiece(int square, PieceType type, PieceColor color) {
+    Bitboard bit = squareBB(square);
+    pieceBB[color][type] |= bit;
+    colorBB[color] |= bit;
+    occupiedBB |= bit;
+    mailbox[square] = encodePiece(type, color);
+    hashKey ^= Zobrist::KEYS.pieces[color][type][square];
+    mgScore += PSQT::TABLES.mg[color][type][square];
+    egScore += PSQT::TABLES.eg[color][type][square];
+    phase += PSQT::PHASE_WEIGHT[type];
+    if (type == PAWN) {
+        pawnKey ^= Zobrist::KEYS.pieces[color][PAWN][square];
+    } else if (type == KING) {
+        kingSquare[color] = square;
+    }
 }
 
-void Board::setTurn(PieceColor color) {
-    turn = color;
+void Board::removePiece(int square) {
+    std::uint8_t code = mailbox[square];
+    if (code == EMPTY_CODE) return;
+
+    Bitboard bit = squareBB(square);
+    pieceBB[code >> 3][code & 7] &= ~bit;
+    colorBB[code >> 3] &= ~bit;
+    occupiedBB &= ~bit;
+    mailbox[square] = EMPTY_CODE;
+    hashKey ^= Zobrist::KEYS.pieces[code >> 3][code & 7][square];
+    mgScore -= PSQT::TABLES.mg[code >> 3][code & 7][square];
+    egScore -= PSQT::TABLES.eg[code >> 3][code & 7][square];
+    phase -= PSQT::PHASE_WEIGHT[code & 7];
+    if ((code & 7) == PAWN) {
+        pawnKey ^= Zobrist::KEYS.pieces[code >> 3][PAWN][square];
+    } else if ((code & 7) == KING) {
+        Bitboard kings = pieceBB[code >> 3][KING];
+        kingSquare[code >> 3] = kings ? lsb(kings) : NO_SQUARE;
+    }
 }
 
-void Board::switchTurn() {
-    turn = (turn == WHITE) ? BLACK : WHITE;
+int Board::changedPieces(int index, NNUE::DirtyPiece changes[4]) const {
+    const UndoInfo& undo = history[index];
+    if (undo.from == NO_SQUARE) {
+        return 0;
+    }
+    int count = 0;
+    if (undo.captured != EMPTY_CODE) {
+        changes[count++] = {undo.captured, undo.captureSquare, false};
+    }
+    changes[count++] = {undo.moved, undo.from, false};
+    changes[count++] = {undo.placed, undo.to, true};
+    if (undo.castling) {
+        int row = squareRow(undo.from);
+        bool kingside = squareCol(undo.to) > squareCol(undo.from);
+        std::uint8_t rook = static_cast<std::uint8_t>(ROOK | (undo.moved & 8));
+        changes[count++] = {rook, static_cast<std::int8_t>(makeSquare(row, kingside ? 7 : 0)), false};
+        changes[count++] = {rook, static_cast<std::int8_t>(makeSquare(row, kingside ? 5 : 3)), true};
+    }
+    return count;
 }
 
-
-bool Board::isSquareAttacked(int row, int col, PieceColor attackerColor) const {
-    for (int r = 0; r < 8; ++r) {
-        for (int c = 0; c < 8; ++c) {
-            Piece piece = getPieceAt(r, c);
-            if (piece.color == attackerColor && !piece.isEmpty()) {
-                std::vector<std::pair<int, int>> attacks = getAttacksFromSquare(r, c);
-                for (const auto& attack : attacks) {
-                    if (attack.first == row && attack.second == col) {
-                        return true;
-                    }
-                }
+std::uint64_t Board::computeHash() const {
+    std::uint64_t key = 0;
+    for (int color = WHITE; color <= BLACK; ++color) {
+        for (int type = PAWN; type <= KING; ++type) {
+            Bitboard pieces = pieceBB[color][type];
+            while (pieces) {
+                key ^= Zobrist::KEYS.pieces[color][type][popLsb(pieces)];
             }
         }
     }
-    return false;
+    key ^= Zobrist::KEYS.castling[castlingRights];
+    if (enPassantSquare != NO_SQUARE) {
+        key ^= Zobrist::KEYS.enPassantFile[squareCol(enPassantSquare)];
+    }
+    if (turn == BLACK) {
+        key ^= Zobrist::KEYS.sideToMove;
+    }
+    return key;
 }
 
-bool Board::isKingInCheck(PieceColor color) const {
-    int kingPos = getKingPosition(color);
-    if (kingPos == -1) return false; 
-    PieceColor opponentColor = (color == WHITE) ? BLACK : WHITE;
-    return isSquareAttacked(kingPos / 8, kingPos % 8, opponentColor);
-}
+std::uint64_t Board::hashAfter(const Move& move) const {
+    int from = move.from();
+    int to = move.to();
+    std::uint8_t moved = mailbox[from];
+    PieceType type = static_cast<PieceType>(moved & 7);
+    PieceColor them = (turn == WHITE) ? BLACK : WHITE;
+
+    std::uint64_t key = hashKey ^ Zobrist::KEYS.sideToMove;
+    key ^= Zobrist::KEYS.pieces[turn][type][from];
+    key ^= Zobrist::KEYS.pieces[turn][move.type() == PROMOTION ? move.promotionPiece() : type][to];
+
+    int captureSquare = (move.type() == EN_PASSANT) ? makeSquare(move.startRow(), move.endCol()) : to;
+    std::uint8_t captured = mailbox[captureSquare];
+    if (captured != EMPTY_CODE) {
+        key ^= Zobrist::KEYS.pieces[captured >> 3][captured & 7][captureSquare];
+    }
 
+    if (move.type() == CASTLING) {
+        int rookFrom = makeSquare(move.startRow(), move.endCol() > move.startCol() ? 7 : 0);
+        int rookTo = makeSquare(move.startRow(), move.endCol() > move.startCol() ? 5 : 3);
+        key ^= Zobrist::KEYS.pieces[turn][ROOK][rookFrom] ^ Zobrist::KEYS.pieces[turn][ROOK][rookTo];
+    }
 
-int Board::getKingPosition(PieceColor color) const {
-    for (int r = 0; r < 8; ++r) {
-        for (int c = 0; c < 8; ++c) {
-            Piece piece = getPieceAt(r, c);
-            if (piece.type == KING && piece.color == color) {
-                return r * 8 + c; 
-            }
+    int rights = castlingRights & ~(castlingMask(from) | castlingMask(to));
+    key ^= Zobrist::KEYS.castling[castlingRights] ^ Zobrist::KEYS.castling[rights];
+
+    if (enPassantSquare != NO_SQUARE) {
+        key ^= Zobrist::KEYS.enPassantFile[squareCol(enPassantSquare)];
+    }
+    if (type == PAWN && std::abs(move.endRow() - move.startRow()) == 2) {
+        int passed = makeSquare((move.startRow() + move.endRow()) / 2, move.startCol());
+        if (Attacks::pawnAttacks(turn, passed) & pieceBB[them][PAWN]) {
+            key ^= Zobrist::KEYS.enPassantFile[squareCol(passed)];
         }
     }
-    return -1; 
+    return key;
 }
 
+void Board::makeMove(const Move& move) {
+    int from = move.from();
+    int to = move.to();
+    std::uint8_t moved = mailbox[from];
+    PieceType type = static_cast<PieceType>(moved & 7);
+
+    UndoInfo undo;
+    undo.from = static_cast<std::int8_t>(from);
+    undo.to = static_cast<std::int8_t>(to);
+    undo.captureSquare = static_cast<std::int8_t>(to);
+    undo.enPassantSquare = static_cast<std::int8_t>(enPassantSquare);
+    undo.moved = moved;
+    undo.castlingRights = static_cast<std::uint8_t>(castlingRights);
+    undo.castling = move.type() == CASTLING;
+    undo.halfmoveClock = halfmoveClock;
+    undo.hash = hashKey;
+
+    if (move.type() == EN_PASSANT) {
+        undo.captureSquare = static_cast<std::int8_t>(makeSquare(move.startRow(), move.endCol()));
+    }
+    undo.captured = mailbox[undo.captureSquare];
 
-std::vector<std::pair<int, int>> Board::getAttacksFromSquare(int row, int col) const {
-    std::vector<std::pair<int, int>> attacks;
-    Piece piece = getPieceAt(row, col);
+    halfmoveClock = (type == PAWN || undo.captured != EMPTY_CODE) ? 0 : halfmoveClock + 1;
+    if (turn == BLACK) fullmoveNumber++;
 
-    if (piece.isEmpty()) return attacks;
+    removePiece(undo.captureSquare);
+    removePiece(from);
+    if (move.type() == PROMOTION) {
+        putPiece(to, move.promotionPiece(), turn);
+    } else {
+        putPiece(to, type, turn);
+    }
+    undo.placed = mailbox[to];
 
-    PieceType type = piece.type;
-    PieceColor color = piece.color;
-    int r, c;
+    if (undo.castling) {
+        int rookFrom = makeSquare(move.startRow(), move.endCol() > move.startCol() ? 7 : 0);
+        int rookTo = makeSquare(move.startRow(), move.endCol() > move.startCol() ? 5 : 3);
+        removePiece(rookFrom);
+        putPiece(rookTo, ROOK, turn);
+    }
 
-    switch (type) {
-        case PAWN: {
-            int direction = (color == WHITE) ? -1 : 1; 
-            int attackRows[] = {row + direction};
-            int attackCols[] = {col - 1, col + 1};
+    hashKey ^= Zobrist::KEYS.castling[castlingRights];
+    castlingRights &= ~(castlingMask(from) | castlingMask(to));
+    hashKey ^= Zobrist::KEYS.castling[castlingRights];
 
-            for (int attackRow : attackRows) {
-                for (int attackCol : attackCols) {
-                    if (attackRow >= 0 && attackRow < 8 && attackCol >= 0 && attackCol < 8) {
-                        attacks.push_back({attackRow, attackCol});
-                    }
-                }
-            }
-            break;
-        }
-        case KNIGHT: {
-            int knightMoves[8][2] = {{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1}};
-            for (const auto& move : knightMoves) {
-                r = row + move[0];
-                c = col + move[1];
-                if (r >= 0 && r < 8 && c >= 0 && c < 8) {
-                    attacks.push_back({r, c});
-                }
-            }
-            break;
-        }
-        case BISHOP:
-        case ROOK:
-        case QUEEN: {
-            int directions[8][2] = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}}; 
-            int startDirIndex = (type == BISHOP) ? 4 : ((type == ROOK) ? 0 : 0); 
-            int endDirIndex   = (type == BISHOP) ? 8 : ((type == ROOK) ? 4 : 8);
-
-            for (int i = startDirIndex; i < endDirIndex; ++i) {
-                int dr = directions[i][0];
-                int dc = directions[i][1];
-                r = row + dr;
-                c = col + dc;
-                while (r >= 0 && r < 8 && c >= 0 && c < 8) {
-                    attacks.push_back({r, c});
-                    if (!getPieceAt(r, c).isEmpty()) { 
-                        break;
-                    }
-                    r += dr;
-                    c += dc;
-                }
-            }
-            break;
+    // Only record an en-passant square an enemy pawn can actually use.
+    if (enPassantSquare != NO_SQUARE) {
+        hashKey ^= Zobrist::KEYS.enPassantFile[squareCol(enPassantSquare)];
+    }
+    enPassantSquare = NO_SQUARE;
+    if (type == PAWN && std::abs(move.endRow() - move.startRow()) == 2) {
+        int passed = makeSquare((move.startRow() + move.endRow()) / 2, move.startCol());
+        PieceColor them = (turn == WHITE) ? BLACK : WHITE;
+        if (Attacks::pawnAttacks(turn, passed) & pieceBB[them][PAWN]) {
+            enPassantSquare = passed;
+            hashKey ^= Zobrist::KEYS.enPassantFile[squareCol(passed)];
         }
-        case KING: {
-            int kingMoves[8][2] = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}};
-            for (const auto& move : kingMoves) {
-                r = row + move[0];
-                c = col + move[1];
-                if (r >= 0 && r < 8 && c >= 0 && c < 8) {
-                    attacks.push_back({r, c});
-                }
-            }
-            break;
+    }
+
+    history.push_back(undo);
+    switchTurn();
+}
+
+void Board::unmakeMove() {
+    if (history.empty()) return;
+
+    UndoInfo undo = history.back();
+    history.pop_back();
+    editIndex = std::min(editIndex, historySize());
+    switchTurn();
+
+    if (turn == BLACK) fullmoveNumber--;
+
+    removePiece(undo.to);
+    putPiece(undo.from, static_cast<PieceType>(undo.moved & 7), turn);
+    if (undo.captured != EMPTY_CODE) {
+        putPiece(undo.captureSquare, static_cast<PieceType>(undo.captured & 7),
+                 static_cast<PieceColor>(undo.captured >> 3));
+    }
+
+    if (undo.castling) {
+        int row = squareRow(undo.from);
+        bool kingside = squareCol(undo.to) > squareCol(undo.from);
+        removePiece(makeSquare(row, kingside ? 5 : 3));
+        putPiece(makeSquare(row, kingside ? 7 : 0), ROOK, turn);
+    }
+
+    castlingRights = undo.castlingRights;
+    enPassantSquare = undo.enPassantSquare;
+    halfmoveClock = undo.halfmoveClock;
+    hashKey = undo.hash;
+}
+
+void Board::makeNullMove() {
+    UndoInfo undo = {};
+    undo.from = undo.to = undo.captureSquare = static_cast<std::int8_t>(NO_SQUARE);
+    undo.enPassantSquare = static_cast<std::int8_t>(enPassantSquare);
+    undo.captured = EMPTY_CODE;
+    undo.castlingRights = static_cast<std::uint8_t>(castlingRights);
+    undo.halfmoveClock = halfmoveClock;
+    undo.hash = hashKey;
+
+    if (enPassantSquare != NO_SQUARE) {
+        hashKey ^= Zobrist::KEYS.enPassantFile[squareCol(enPassantSquare)];
+    }
+    enPassantSquare = NO_SQUARE;
+    halfmoveClock++;
+    history.push_back(undo);
+    switchTurn();
+}
+
+void Board::unmakeNullMove() {
+    if (history.empty()) return;
+
+    UndoInfo undo = history.back();
+    history.pop_back();
+    editIndex = std::min(editIndex, historySize());
+    switchTurn();
+
+    enPassantSquare = undo.enPassantSquare;
+    halfmoveClock = undo.halfmoveClock;
+    hashKey = undo.hash;
+}
+
+PieceColor Board::getTurn() const {
+    return turn;
+}
+
+void Board::setTurn(PieceColor color) {
+    if (color != turn) {
+        hashKey ^= Zobrist::KEYS.sideToMove;
+    }
+    turn = color;
+}
+
+void Board::switchTurn() {
+    turn = (turn == WHITE) ? BLACK : WHITE;
+    hashKey ^= Zobrist::KEYS.sideToMove;
+}
+
+
+// Every piece of either color attacking the square, with sliders seen
+// through the given occupancy.
+Bitboard Board::attackersTo(int square, Bitboard occupied) const {
+    Bitboard bishopsQueens = pieces(BISHOP) | pieces(QUEEN);
+    Bitboard rooksQueens = pieces(ROOK) | pieces(QUEEN);
+    return (Attacks::pawnAttacks(WHITE, square) & pieceBB[BLACK][PAWN]) |
+           (Attacks::pawnAttacks(BLACK, square) & pieceBB[WHITE][PAWN]) |
+           (Attacks::knightAttacks(square) & pieces(KNIGHT)) |
+           (Attacks::kingAttacks(square) & pieces(KING)) |
+           (Attacks::bishopAttacks(square, occupied) & bishopsQueens) |
+           (Attacks::rookAttacks(square, occupied) & rooksQueens);
+}
+
+Bitboard Board::checkers() const {
+    int king = getKingPosition(turn);
+    if (king == -1) return EMPTY_BB;
+    PieceColor them = (turn == WHITE) ? BLACK : WHITE;
+    return attackersTo(king, occupiedBB) & colorBB[them];
+}
+
+// Pieces of the given color that are the only blocker between their own
+// king and an enemy slider.
+Bitboard Board::pinnedPieces(PieceColor color) const {
+    int king = getKingPosition(color);
+    if (king == -1) return EMPTY_BB;
+    PieceColor them = (color == WHITE) ? BLACK : WHITE;
+
+    Bitboard snipers = ((Attacks::rookAttacks(king, EMPTY_BB) & (pieceBB[them][ROOK] | pieceBB[them][QUEEN])) |
+                        (Attacks::bishopAttacks(king, EMPTY_BB) & (pieceBB[them][BISHOP] | pieceBB[them][QUEEN])));
+    Bitboard pinned = EMPTY_BB;
+    while (snipers) {
+        Bitboard blockers = Attacks::between(king, popLsb(snipers)) & occupiedBB;
+        if (blockers && !moreThanOne(blockers) && (blockers & colorBB[color])) {
+            pinned |= blockers;
         }
-        default:
-            break;
     }
-    return attacks;
+    return pinned;
+}
+
+// Reverse lookup: a piece of type T attacks the square exactly when a T
+// standing on the square would attack it (pawns use the defender's pattern).
+bool Board::isSquareAttacked(int row, int col, PieceColor attackerColor) const {
+    if (attackerColor == NONE) return false;
+
+    int square = makeSquare(row, col);
+    PieceColor defender = (attackerColor == WHITE) ? BLACK : WHITE;
+    const Bitboard* attackers = pieceBB[attackerColor];
+    return (Attacks::pawnAttacks(defender, square) & attackers[PAWN]) ||
+           (Attacks::knightAttacks(square) & attackers[KNIGHT]) ||
+           (Attacks::kingAttacks(square) & attackers[KING]) ||
+           (Attacks::bishopAttacks(square, occupiedBB) & (attackers[BISHOP] | attackers[QUEEN])) ||
+           (Attacks::rookAttacks(square, occupiedBB) & (attackers[ROOK] | attackers[QUEEN]));
+}
+
+bool Board::isKingInCheck(PieceColor color) const {
+    int kingPos = getKingPosition(color);
+    if (kingPos == NO_SQUARE) return false;
+    PieceColor opponentColor = (color == WHITE) ? BLACK : WHITE;
+    return isSquareAttacked(squareRow(kingPos), squareCol(kingPos), opponentColor);
+}
+
+
+Bitboard Board::getAttacksFromSquare(int square) const {
+    std::uint8_t code = mailbox[square];
+    if (code == EMPTY_CODE) return EMPTY_BB;
+    return Attacks::attacksFrom(static_cast<PieceType>(code & 7), static_cast<PieceColor>(code >> 3),
+                                square, occupiedBB);
 }
 
 bool Board::isMoveLegal(int startRow, int startCol, int endRow, int endCol) const {
@@ -339,17 +608,8 @@ bool Board::isMoveLegal(int startRow, int startCol, int endRow, int endCol) cons
         return false;
     }
 
-    std::vector<std::pair<int, int>> attacks = getAttacksFromSquare(startRow, startCol);
-    
-    bool moveFound = false;
-    for (const auto& attack : attacks) {
-        if (attack.first == endRow && attack.second == endCol) {
-            moveFound = true;
-            break;
-        }
-    }
-    
-    if (!moveFound) {
+    Bitboard attacks = getAttacksFromSquare(makeSquare(startRow, startCol));
+    if (!(attacks & squareBB(makeSquare(endRow, endCol)))) {
         return false;
     }
 
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "bitboard.h"
+#include "nnue_accumulator.h"
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -12,6 +15,17 @@ enum PieceColor {
     WHITE, BLACK, NONE
 };
 
+enum CastlingRight {
+    NO_CASTLING = 0,
+    WHITE_KINGSIDE = 1,
+    WHITE_QUEENSIDE = 2,
+    BLACK_KINGSIDE = 4,
+    BLACK_QUEENSIDE = 8,
+    ALL_CASTLING = 15
+};
+
+struct Move;
+
 struct Piece {
     PieceType type;
     PieceColor color;
@@ -24,10 +38,12 @@ struct Piece {
 
 class Board {
 public:
+    static const int NO_SQUARE = -1;
+
     Board();
     Board(const std::string& fen);
-    Board(const Board& other);
-    Board& operator=(const Board& other);
+    Board(const Board& other) = default;
+    Board& operator=(const Board& other) = default;
 
     void initializeStandardSetup();
     void loadFen(const std::string& fen);
@@ -39,20 +55,114 @@ public:
     void movePiece(int startRow, int startCol, int endRow, int endCol);
     void clearBoard();
 
+    void makeMove(const Move& move);
+    void unmakeMove();
+    void makeNullMove();
+    void unmakeNullMove();
+
     PieceColor getTurn() const;
     void setTurn(PieceColor color);
     void switchTurn();
 
+    int getCastlingRights() const { return castlingRights; }
+    int getEnPassantSquare() const { return enPassantSquare; }
+    int getHalfmoveClock() const { return halfmoveClock; }
+    int getFullmoveNumber() const { return fullmoveNumber; }
+    std::uint64_t hash() const { return hashKey; }
+    // The key makeMove(move) would produce, without making it, so the search
+    // can prefetch the child's table entry before it pays for the move.
+    std::uint64_t hashAfter(const Move& move) const;
+    // Zobrist key of the pawns alone, for the pawn structure cache.
+    std::uint64_t pawnHash() const { return pawnKey; }
+
+    // Material plus piece-square sums from White's point of view, for the
+    // middlegame and endgame tables, and the phase that blends them.
+    int midgameScore() const { return mgScore; }
+    int endgameScore() const { return egScore; }
+    int gamePhase() const { return phase; }
+
+    Bitboard pieces(PieceColor color, PieceType type) const { return pieceBB[color][type]; }
+    Bitboard pieces(PieceType type) const { return pieceBB[WHITE][type] | pieceBB[BLACK][type]; }
+    Bitboard occupancy(PieceColor color) const { return colorBB[color]; }
+    Bitboard occupancy() const { return occupiedBB; }
+
+    Bitboard attackersTo(int square, Bitboard occupied) const;
+    Bitboard checkers() const;
+    Bitboard pinnedPieces(PieceColor color) const;
+
     bool isSquareAttacked(int row, int col, PieceColor attackerColor) const;
     bool isKingInCheck(PieceColor color) const;
     bool isMoveLegal(int startRow, int startCol, int endRow, int endCol) const;
     bool isCapture(int startRow, int startCol, int endRow, int endCol) const;
     bool isCastling(int startRow, int startCol, int endRow, int endCol) const;
-    int getKingPosition(PieceColor color) const;
+    int getKingPosition(PieceColor color) const { return color == NONE ? NO_SQUARE : kingSquare[color]; }
+
+    // Moving piece (type | color << 3) and destination of the move made
+    // pliesAgo plies before this position, 1 being the last. False for a null
+    // move or past the start of the history.
+    bool previousMove(int pliesAgo, int& piece, int& to) const {
+        if (pliesAgo > static_cast<int>(history.size())) return false;
+        const UndoInfo& undo = history[history.size() - pliesAgo];
+        if (undo.from == NO_SQUARE) return false;
+        piece = undo.moved;
+        to = undo.to;
+        return true;
+    }
+
+    // The history as seen by an evaluator that updates along it (NNUE):
+    // positionHash(i) is the hash of the position before the i-th move of the
+    // history, positionHash(historySize()) the current one. Positions before
+    // lastEditIndex() cannot be replayed into this one, because a piece was
+    // set up or moved outside makeMove after them.
+    int historySize() const { return static_cast<int>(history.size()); }
+    int lastEditIndex() const { return editIndex; }
+    std::uint64_t positionHash(int index) const {
+        return index == historySize() ? hashKey : history[index].hash;
+    }
+    // The pieces the index-th move of the history took off and put on the
+    // board, at most four; none for a null move.
+    int changedPieces(int index, NNUE::DirtyPiece changes[4]) const;
 
 private:
-    Piece board[8][8];
-    PieceColor turn; 
+    // Everything makeMove cannot recompute when the move is taken back.
+    struct UndoInfo {
+        std::int8_t from;
+        std::int8_t to;
+        std::int8_t captureSquare;
+        std::int8_t enPassantSquare;
+        std::uint8_t moved;
+        std::uint8_t placed;  // differs from moved for a promotion
+        std::uint8_t captured;
+        std::uint8_t castlingRights;
+        bool castling;
+        int halfmoveClock;
+        std::uint64_t hash;
+    };
+
+    // One set per piece type and color plus the derived occupancy sets. The
+    // mailbox mirrors them so getPieceAt is a single byte load.
+    Bitboard pieceBB[2][6];
+    Bitboard colorBB[2];
+    Bitboard occupiedBB;
+    std::uint8_t mailbox[64];
+    int kingSquare[2];
+    int mgScore;
+    int egScore;
+    int phase;
 
-    std::vector<std::pair<int, int>> getAttacksFromSquare(int row, int col) const;
-};
\ No newline at end of file
+    PieceColor turn;
+    int castlingRights;
+    int enPassantSquare;
+    int halfmoveClock;
+    int fullmoveNumber;
+    std::uint64_t hashKey;
+    std::uint64_t pawnKey;
+    std::vector<UndoInfo> history;
+    int editIndex;
+
+    void putPiece(int square, PieceType type, PieceColor color);
+    void removePiece(int square);
+    std::uint64_t computeHash() const;
+
+    Bitboard getAttacksFromSquare(int square) const;
+};
@@ -0,0 +1,66 @@
+#include "cpu_features.h"
+
+#if CHESS_X86
+#if defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace {
+
+#if CHESS_X86
+void cpuid(int leaf, int regs[4]) {
+#if defined(_MSC_VER)
+    __cpuidex(regs, leaf, 0);
+#else
+    unsigned a, b, c, d;
+    __cpuid_count(leaf, 0, a, b, c, d);
+    regs[0] = static_cast<int>(a);
+    regs[1] = static_cast<int>(b);
+    regs[2] = static_cast<int>(c);
+    regs[3] = static_cast<int>(d);
+#endif
+}
+#endif
+
+CpuFeatures detect() {
+    CpuFeatures features = {};
+#if CHESS_X86
+    int regs[4];
+    cpuid(0, regs);
+    int maxLeaf = regs[0];
+
+#if defined(_MSC_VER)
+    cpuid(1, regs);
+    features.sse41 = (regs[2] & (1 << 19)) != 0;
+    bool osxsave = (regs[2] & (1 << 27)) && (regs[2] & (1 << 28));
+    unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+    bool osSavesAvx = (xcr0 & 0x6) == 0x6;
+    bool osSavesAvx512 = (xcr0 & 0xE6) == 0xE6;
+    if (maxLeaf >= 7) {
+        cpuid(7, regs);
+        features.bmi2 = (regs[1] & (1 << 8)) != 0;
+        features.avx2 = osSavesAvx && (regs[1] & (1 << 5)) != 0;
+        features.avx512bw = osSavesAvx512 && (regs[1] & (1 << 16)) && (regs[1] & (1 << 30));
+    }
+#else
+    // The builtin also checks that the OS saves the vector registers.
+    __builtin_cpu_init();
+    features.sse41 = __builtin_cpu_supports("sse4.1");
+    features.bmi2 = maxLeaf >= 7 && __builtin_cpu_supports("bmi2");
+    features.avx2 = maxLeaf >= 7 && __builtin_cpu_supports("avx2");
+    features.avx512bw = maxLeaf >= 7 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#endif
+#endif
+    return features;
+}
+
+}
+
+const CpuFeatures& cpuFeatures() {
+    static const CpuFeatures features = detect();
+    return features;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+// Instruction set extensions the engine can dispatch on at runtime. Code
+// using them is compiled per function with TARGET_ATTRIBUTE, so the rest of
+// the binary still runs on any x86-64 (or non-x86) CPU.
+#if defined(__x86_64__) || defined(_M_X64)
+#define CHESS_X86 1
+#else
+#define CHESS_X86 0
+#endif
+
+#if CHESS_X86 && !defined(_MSC_VER)
+#define TARGET_ATTRIBUTE(isa) __attribute__((target(isa)))
+#else
+#define TARGET_ATTRIBUTE(isa)
+#endif
+
+struct CpuFeatures {
+    bool sse41;
+    bool avx2;
+    bool avx512bw;
+    bool bmi2;
+};
+
+// Detected once, on first use.
+const CpuFeatures& cpuFeatures();
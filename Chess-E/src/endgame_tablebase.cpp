@@ -20,7 +20,7 @@ Move EndgameTablebase::getBestMove(const Board& board) {
         EndgamePattern pattern = analyzePosition(board);
         return findBestEndgameMove(board, pattern);
     }
-    return Move(-1, -1, -1, -1);
+    return Move();
 }
 
 bool EndgameTablebase::isEndgamePosition(const Board& board) const {
@@ -29,8 +29,7 @@ bool EndgameTablebase::isEndgamePosition(const Board& board) const {
 }
 
 EndgameTablebase::EndgamePattern EndgameTablebase::analyzePosition(const Board& board) const {
-    std::string fen = board.toFen();
-    auto it = patternCache.find(fen);
+    auto it = patternCache.find(board.hash());
     if (it != patternCache.end()) {
         return it->second;
     }
@@ -57,7 +56,7 @@ EndgameTablebase::EndgamePattern EndgameTablebase::analyzePosition(const Board&
                        (pattern.whitePieces[QUEEN] == 0 && pattern.blackPieces[QUEEN] == 0) || 
                        (totalPieces <= 16 && pattern.whitePieces[PAWN] + pattern.blackPieces[PAWN] <= 4);
 
-    patternCache[fen] = pattern;
+    patternCache[board.hash()] = pattern;
     return pattern;
 }
 
@@ -91,7 +90,7 @@ int EndgameTablebase::evaluateEndgame(const Board& board, const EndgamePattern&
 
 Move EndgameTablebase::findBestEndgameMove(const Board& board, const EndgamePattern& pattern) const {
     if (!pattern.isEndgame) {
-        return Move(-1, -1, -1, -1);
+        return Move();
     }
 
     if (isKingAndPawnEndgame(pattern)) {
@@ -110,7 +109,7 @@ Move EndgameTablebase::findBestEndgameMove(const Board& board, const EndgamePatt
         return findQueenEndgameMove(board);
     }
 
-    return Move(-1, -1, -1, -1);
+    return Move();
 }
 
 bool EndgameTablebase::isKingAndPawnEndgame(const EndgamePattern& pattern) const {
@@ -145,33 +144,33 @@ bool EndgameTablebase::isQueenEndgame(const EndgamePattern& pattern) const {
 }
 
 Move EndgameTablebase::findKingAndPawnEndgameMove(const Board& board) const {
-    std::vector<Move> legalMoves = MoveGenerator().generateLegalMoves(board);
+    MoveList legalMoves = MoveGenerator().generateLegalMoves(board);
     if (legalMoves.empty()) {
-        return Move(-1, -1, -1, -1);
+        return Move();
     }
 
     for (const auto& move : legalMoves) {
-        Piece piece = board.getPieceAt(move.startRow, move.startCol);
+        Piece piece = board.getPieceAt(move.startRow(), move.startCol());
         if (piece.type == PAWN) {
-            if ((piece.color == WHITE && move.endRow == 0) ||
-                (piece.color == BLACK && move.endRow == 7)) {
+            if ((piece.color == WHITE && move.endRow() == 0) ||
+                (piece.color == BLACK && move.endRow() == 7)) {
                 return move; 
             }
-            if (abs(move.endRow - move.startRow) == 1 && move.startCol == move.endCol) {
+            if (abs(move.endRow() - move.startRow()) == 1 && move.startCol() == move.endCol()) {
                 return move;
             }
         }
     }
 
-    Move bestKingMove = Move(-1, -1, -1, -1);
+    Move bestKingMove = Move();
     int bestScore = -Evaluation::INFINITY_VALUE;
 
     for (const auto& move : legalMoves) {
-        Piece piece = board.getPieceAt(move.startRow, move.startCol);
+        Piece piece = board.getPieceAt(move.startRow(), move.startCol());
         if (piece.type == KING) {
             int score = 0;
-            score += (3 - abs(move.endCol - 3.5)) * 10;
-            score += (3 - abs(move.endRow - 3.5)) * 10;
+            score += (3 - abs(move.endCol() - 3.5)) * 10;
+            score += (3 - abs(move.endRow() - 3.5)) * 10;
             
             if (score > bestScore) {
                 bestScore = score;
@@ -180,26 +179,26 @@ Move EndgameTablebase::findKingAndPawnEndgameMove(const Board& board) const {
         }
     }
 
-    return bestKingMove.startRow != -1 ? bestKingMove : legalMoves[0];
+    return bestKingMove.isValid() ? bestKingMove : legalMoves[0];
 }
 
 Move EndgameTablebase::findRookEndgameMove(const Board& board) const {
-    std::vector<Move> legalMoves = MoveGenerator().generateLegalMoves(board);
+    MoveList legalMoves = MoveGenerator().generateLegalMoves(board);
     if (legalMoves.empty()) {
-        return Move(-1, -1, -1, -1);
+        return Move();
     }
 
-    Move bestRookMove = Move(-1, -1, -1, -1);
+    Move bestRookMove = Move();
     int bestScore = -Evaluation::INFINITY_VALUE;
 
     for (const auto& move : legalMoves) {
-        Piece piece = board.getPieceAt(move.startRow, move.startCol);
+        Piece piece = board.getPieceAt(move.startRow(), move.startCol());
         if (piece.type == ROOK) {
             int score = 0;
             bool isOpenFile = true;
             for (int r = 0; r < 8; ++r) {
-                if (r != move.endRow) {
-                    Piece blockingPiece = board.getPieceAt(r, move.endCol);
+                if (r != move.endRow()) {
+                    Piece blockingPiece = board.getPieceAt(r, move.endCol());
                     if (!blockingPiece.isEmpty()) {
                         isOpenFile = false;
                         break;
@@ -208,14 +207,14 @@ Move EndgameTablebase::findRookEndgameMove(const Board& board) const {
             }
             if (isOpenFile) score += 50;
 
-            Piece targetPiece = board.getPieceAt(move.endRow, move.endCol);
+            Piece targetPiece = board.getPieceAt(move.endRow(), move.endCol());
             if (!targetPiece.isEmpty() && targetPiece.type == PAWN && targetPiece.color != piece.color) {
                 score += 30;
             }
 
             for (int r = 0; r < 8; ++r) {
-                if (r != move.endRow) {
-                    Piece friendlyPiece = board.getPieceAt(r, move.endCol);
+                if (r != move.endRow()) {
+                    Piece friendlyPiece = board.getPieceAt(r, move.endCol());
                     if (!friendlyPiece.isEmpty() && friendlyPiece.type == PAWN && friendlyPiece.color == piece.color) {
                         score += 20;
                     }
@@ -229,34 +228,34 @@ Move EndgameTablebase::findRookEndgameMove(const Board& board) const {
         }
     }
 
-    return bestRookMove.startRow != -1 ? bestRookMove : legalMoves[0];
+    return bestRookMove.isValid() ? bestRookMove : legalMoves[0];
 }
 
 Move EndgameTablebase::findBishopEndgameMove(const Board& board) const {
-    std::vector<Move> legalMoves = MoveGenerator().generateLegalMoves(board);
+    MoveList legalMoves = MoveGenerator().generateLegalMoves(board);
     if (legalMoves.empty()) {
-        return Move(-1, -1, -1, -1);
+        return Move();
     }
 
-    Move bestBishopMove = Move(-1, -1, -1, -1);
+    Move bestBishopMove = Move();
     int bestScore = -Evaluation::INFINITY_VALUE;
 
     for (const auto& move : legalMoves) {
-        Piece piece = board.getPieceAt(move.startRow, move.startCol);
+        Piece piece = board.getPieceAt(move.startRow(), move.startCol());
         if (piece.type == BISHOP) {
             int score = 0;
-            if (move.endRow + move.endCol == 7 || move.endRow - move.endCol == 0) {
+            if (move.endRow() + move.endCol() == 7 || move.endRow() - move.endCol() == 0) {
                 score += 30;
             }
 
-            Piece targetPiece = board.getPieceAt(move.endRow, move.endCol);
+            Piece targetPiece = board.getPieceAt(move.endRow(), move.endCol());
             if (!targetPiece.isEmpty() && targetPiece.type == PAWN && targetPiece.color != piece.color) {
                 score += 30;
             }
 
             for (int r = 0; r < 8; ++r) {
                 for (int c = 0; c < 8; ++c) {
-                    if (r + c == move.endRow + move.endCol || r - c == move.endRow - move.endCol) {
+                    if (r + c == move.endRow() + move.endCol() || r - c == move.endRow() - move.endCol()) {
                         Piece friendlyPiece = board.getPieceAt(r, c);
                         if (!friendlyPiece.isEmpty() && friendlyPiece.type == PAWN && friendlyPiece.color == piece.color) {
                             score += 20;
@@ -272,35 +271,35 @@ Move EndgameTablebase::findBishopEndgameMove(const Board& board) const {
         }
     }
 
-    return bestBishopMove.startRow != -1 ? bestBishopMove : legalMoves[0];
+    return bestBishopMove.isValid() ? bestBishopMove : legalMoves[0];
 }
 
 Move EndgameTablebase::findKnightEndgameMove(const Board& board) const {
-    std::vector<Move> legalMoves = MoveGenerator().generateLegalMoves(board);
+    MoveList legalMoves = MoveGenerator().generateLegalMoves(board);
     if (legalMoves.empty()) {
-        return Move(-1, -1, -1, -1);
+        return Move();
     }
 
-    Move bestKnightMove = Move(-1, -1, -1, -1);
+    Move bestKnightMove = Move();
     int bestScore = -Evaluation::INFINITY_VALUE;
 
     for (const auto& move : legalMoves) {
-        Piece piece = board.getPieceAt(move.startRow, move.startCol);
+        Piece piece = board.getPieceAt(move.startRow(), move.startCol());
         if (piece.type == KNIGHT) {
             int score = 0;
-            if (move.endRow >= 2 && move.endRow <= 5 && move.endCol >= 2 && move.endCol <= 5) {
+            if (move.endRow() >= 2 && move.endRow() <= 5 && move.endCol() >= 2 && move.endCol() <= 5) {
                 score += 30;
             }
 
-            Piece targetPiece = board.getPieceAt(move.endRow, move.endCol);
+            Piece targetPiece = board.getPieceAt(move.endRow(), move.endCol());
             if (!targetPiece.isEmpty() && targetPiece.type == PAWN && targetPiece.color != piece.color) {
                 score += 30;
             }
 
             for (int r = 0; r < 8; ++r) {
                 for (int c = 0; c < 8; ++c) {
-                    if ((abs(r - move.endRow) == 2 && abs(c - move.endCol) == 1) ||
-                        (abs(r - move.endRow) == 1 && abs(c - move.endCol) == 2)) {
+                    if ((abs(r - move.endRow()) == 2 && abs(c - move.endCol()) == 1) ||
+                        (abs(r - move.endRow()) == 1 && abs(c - move.endCol()) == 2)) {
                         Piece friendlyPiece = board.getPieceAt(r, c);
                         if (!friendlyPiece.isEmpty() && friendlyPiece.type == PAWN && friendlyPiece.color == piece.color) {
                             score += 20;
@@ -316,36 +315,36 @@ Move EndgameTablebase::findKnightEndgameMove(const Board& board) const {
         }
     }
 
-    return bestKnightMove.startRow != -1 ? bestKnightMove : legalMoves[0];
+    return bestKnightMove.isValid() ? bestKnightMove : legalMoves[0];
 }
 
 Move EndgameTablebase::findQueenEndgameMove(const Board& board) const {
-    std::vector<Move> legalMoves = MoveGenerator().generateLegalMoves(board);
+    MoveList legalMoves = MoveGenerator().generateLegalMoves(board);
     if (legalMoves.empty()) {
-        return Move(-1, -1, -1, -1);
+        return Move();
     }
 
-    Move bestQueenMove = Move(-1, -1, -1, -1);
+    Move bestQueenMove = Move();
     int bestScore = -Evaluation::INFINITY_VALUE;
 
     for (const auto& move : legalMoves) {
-        Piece piece = board.getPieceAt(move.startRow, move.startCol);
+        Piece piece = board.getPieceAt(move.startRow(), move.startCol());
         if (piece.type == QUEEN) {
             int score = 0;
 
-            if (move.endRow >= 2 && move.endRow <= 5 && move.endCol >= 2 && move.endCol <= 5) {
+            if (move.endRow() >= 2 && move.endRow() <= 5 && move.endCol() >= 2 && move.endCol() <= 5) {
                 score += 30;
             }
 
-            Piece targetPiece = board.getPieceAt(move.endRow, move.endCol);
+            Piece targetPiece = board.getPieceAt(move.endRow(), move.endCol());
             if (!targetPiece.isEmpty() && targetPiece.color != piece.color) {
                 score += 30;
             }
 
             for (int r = 0; r < 8; ++r) {
                 for (int c = 0; c < 8; ++c) {
-                    if (r == move.endRow || c == move.endCol ||
-                        r + c == move.endRow + move.endCol || r - c == move.endRow - move.endCol) {
+                    if (r == move.endRow() || c == move.endCol() ||
+                        r + c == move.endRow() + move.endCol() || r - c == move.endRow() - move.endCol()) {
                         Piece friendlyPiece = board.getPieceAt(r, c);
                         if (!friendlyPiece.isEmpty() && friendlyPiece.color == piece.color) {
                             score += 20;
@@ -361,5 +360,5 @@ Move EndgameTablebase::findQueenEndgameMove(const Board& board) const {
         }
     }
 
-    return bestQueenMove.startRow != -1 ? bestQueenMove : legalMoves[0];
+    return bestQueenMove.isValid() ? bestQueenMove : legalMoves[0];
 }
\ No newline at end of file
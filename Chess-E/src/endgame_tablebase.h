@@ -3,6 +3,7 @@
 #include "board.h"
 #include "move.h"
 #include "evaluation.h"
+#include <cstdint>
 #include <unordered_map>
 #include <vector>
 
@@ -36,5 +37,5 @@ private:
     bool isKnightEndgame(const EndgamePattern& pattern) const;
     bool isQueenEndgame(const EndgamePattern& pattern) const;
     
-    mutable std::unordered_map<std::string, EndgamePattern> patternCache;
+    mutable std::unordered_map<std::uint64_t, EndgamePattern> patternCache;
 };
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "eval_cache.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace {
+
+// Cost of the two clock reads around a timed probe, measured once so the
+// reported latency is the probe alone.
+std::uint64_t clockOverhead() {
+    static const std::uint64_t overhead = [] {
+        std::int64_t best = std::numeric_limits<std::int64_t>::max();
+        for (int i = 0; i < 64; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            auto end = std::chrono::steady_clock::now();
+            best = std::min<std::int64_t>(best, std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        }
+        return static_cast<std::uint64_t>(best);
+    }();
+    return overhead;
+}
+
+}
+
+EvalCache::EvalCache() : entries(new std::uint64_t[SIZE]()), counters() {
+    clockOverhead();
+}
+
+bool EvalCache::probe(std::uint64_t key, int& value) {
+    bool timed = (counters.probes++ % TIMING_INTERVAL) == 0;
+    auto start = timed ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
+    std::uint64_t entry = entries[key & (SIZE - 1)];
+    bool hit = entry != 0 && ((entry ^ key) & ~VALUE_MASK) == 0;
+    if (hit) {
+        value = static_cast<std::int16_t>(entry & VALUE_MASK);
+        counters.hits++;
+    }
+
+    if (timed) {
+        auto elapsed = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        counters.timedProbes++;
+        counters.timedNanoseconds += elapsed > clockOverhead() ? elapsed - clockOverhead() : 0;
+    }
+    return hit;
+}
+
+void EvalCache::store(std::uint64_t key, int value) {
+    // Values beyond 16 bits only occur without kings; they are not cached.
+    if (value < std::numeric_limits<std::int16_t>::min() || value > std::numeric_limits<std::int16_t>::max()) {
+        return;
+    }
+    entries[key & (SIZE - 1)] = (key & ~VALUE_MASK) | static_cast<std::uint16_t>(value);
+}
+
+void EvalCache::resetStats() {
+    counters = Stats();
+}
+
+EvalCache& EvalCache::forThread() {
+    thread_local EvalCache cache;
+    return cache;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Static evaluations keyed by the position's Zobrist hash. Quiescence
+// reaches the same leaves again through transpositions, and a hit costs one
+// cache-line probe instead of a full evaluation. Each thread owns its table,
+// so no locking or atomics are involved.
+class EvalCache {
+public:
+    static const std::size_t SIZE = std::size_t(1) << 16;
+
+    struct Stats {
+        std::uint64_t probes;
+        std::uint64_t hits;
+        std::uint64_t timedProbes;
+        std::uint64_t timedNanoseconds;
+
+        double hitRate() const { return probes ? 100.0 * hits / probes : 0.0; }
+        double probeNanoseconds() const {
+            return timedProbes ? static_cast<double>(timedNanoseconds) / timedProbes : 0.0;
+        }
+    };
+
+    EvalCache();
+
+    bool probe(std::uint64_t key, int& value);
+    void store(std::uint64_t key, int value);
+
+    const Stats& stats() const { return counters; }
+    void resetStats();
+
+    static EvalCache& forThread();
+
+private:
+    // The upper 48 key bits and the 16-bit value share one word, so an entry
+    // is a single load and a single store.
+    static const std::uint64_t VALUE_MASK = 0xFFFF;
+    // One probe in this many is timed; timing every probe would cost more
+    // than the probe itself.
+    static const std::uint64_t TIMING_INTERVAL = 1024;
+
+    std::unique_ptr<std::uint64_t[]> entries;
+    Stats counters;
+};
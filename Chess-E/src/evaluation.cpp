@@ -1,244 +1,125 @@
 #include "evaluation.h"
-#include "movegen.h"
-#include <cmath>
+#include "attacks.h"
+#include "eval_cache.h"
+#include "nnue.h"
+#include "pawn_table.h"
+#include "psqt.h"
+#include <algorithm>
 
 Evaluation::Evaluation() {}
 
-int Evaluation::evaluate(const Board& board) const {
-    if (board.isKingInCheck(WHITE) && MoveGenerator().generateLegalMoves(board).empty()) return -CHECKMATE_VALUE;
-    if (board.isKingInCheck(BLACK) && MoveGenerator().generateLegalMoves(board).empty()) return CHECKMATE_VALUE;
-    if (MoveGenerator().generateLegalMoves(board).empty()) return 0;
+namespace {
 
-    int score = 0;
-    score += materialValue(board);
-    score += positionValue(board);
-    score += mobilityValue(board);
-    score += pawnStructureValue(board);
-    score += kingSafetyValue(board);
+int lazyMarginValue = Evaluation::DEFAULT_LAZY_MARGIN;
 
-    return (board.getTurn() == WHITE) ? score : -score;
 }
 
-int Evaluation::pieceValue(PieceType type) const {
-    switch (type) {
-        case PAWN: return 100;
-        case KNIGHT: return 320;
-        case BISHOP: return 330;
-        case ROOK: return 500;
-        case QUEEN: return 900;
-        case KING: return 20000;
-        default: return 0;
-    }
+int Evaluation::evaluate(const Board& board) const {
+    return evaluate(board, -INFINITY_VALUE, INFINITY_VALUE);
 }
 
-int Evaluation::pieceSquareBonus(PieceType type, PieceColor color, int row, int col, const Board& board) const {
-    int bonus = 0;
-    
-    if (type == PAWN) {
-        int centralBonus = abs(3.5 - col);
-        bonus = (color == WHITE) ? (7 - row) * 5 : row * 5;
-        bonus += (4 - centralBonus) * 2;
-    }
-    else if (type == KNIGHT) {
-        int edgePenalty = (col == 0 || col == 7) ? -15 : 0;
-        edgePenalty += (row == 0 || row == 7) ? -15 : 0;
-        int centralBonus = (col >= 2 && col <= 5 && row >= 2 && row <= 5) ? 20 : 0;
-        bonus = centralBonus + edgePenalty;
-    }
-    else if (type == BISHOP) {
-        int diagonalBonus = (abs(row - col) == 0 || abs(row - col) == 7) ? 15 : 0;
-        bonus = diagonalBonus;
-    }
-    else if (type == ROOK) {
-        int seventhRank = (color == WHITE && row == 1) || (color == BLACK && row == 6) ? 30 : 0;
-        bonus = seventhRank;
+int Evaluation::evaluate(const Board& board, int alpha, int beta) const {
+    EvalCache& cache = EvalCache::forThread();
+    std::uint64_t key = board.hash() ^ (NNUE::isEnabled() ? NNUE::networkId() : 0);
+    int value;
+    if (cache.probe(key, value)) {
+        return value;
     }
-    else if (type == KING) {
-        bool endgame = isEndgame(board);
-        if (endgame) {
-            int centralBonus = 14 - (abs(3.5 - row) + abs(3.5 - col)) * 2;
-            bonus = centralBonus;
-        }
-        else {
-            int cornerBonus = (row >= 6 && (col <= 2 || col >= 5)) ? 20 : 0;
-            cornerBonus = (color == BLACK) ? (row <= 1 && (col <= 2 || col >= 5)) ? 20 : 0 : cornerBonus;
-            bonus = cornerBonus;
+
+    LazyStats& stats = lazyStats();
+    stats.evaluations++;
+    // The network has no cheap tier; it always runs in full.
+    if (lazyMarginValue > 0 && !NNUE::isEnabled()) {
+        int estimate = evaluateTerms<MATERIAL_TIER>(board);
+        if (estimate + lazyMarginValue <= alpha || estimate - lazyMarginValue >= beta) {
+            // Not cached: a later probe with a wider window needs the full value.
+            stats.lazyExits++;
+            return estimate;
         }
     }
-    
-    return bonus;
+
+    value = evaluateUncached(board);
+    cache.store(key, value);
+    return value;
 }
 
-int Evaluation::materialValue(const Board& board) const {
-    int score = 0;
-    for (int row = 0; row < 8; ++row) {
-        for (int col = 0; col < 8; ++col) {
-            Piece piece = board.getPieceAt(row, col);
-            if (!piece.isEmpty()) {
-                int value = pieceValue(piece.type);
-                score += (piece.color == WHITE) ? value : -value;
-            }
-        }
+int Evaluation::evaluateUncached(const Board& board) const {
+    // HalfKP features are relative to each side's king, so test positions
+    // without one fall back to the hand-written evaluation.
+    if (NNUE::isEnabled() && board.pieces(WHITE, KING) && board.pieces(BLACK, KING)) {
+        return NNUE::evaluate(board);
     }
-    return score;
+    return evaluateClassical(board);
 }
 
-int Evaluation::positionValue(const Board& board) const {
-    int score = 0;
-    for (int row = 0; row < 8; ++row) {
-        for (int col = 0; col < 8; ++col) {
-            Piece piece = board.getPieceAt(row, col);
-            if (!piece.isEmpty()) {
-                int bonus = pieceSquareBonus(piece.type, piece.color, row, col, board);
-                score += (piece.color == WHITE) ? bonus : -bonus;
-            }
-        }
+int Evaluation::evaluateClassical(const Board& board) const {
+    return evaluateTerms<FULL_TIER>(board);
+}
+
+// Mate and stalemate are the search's business: it already knows when a
+// node has no legal moves, so the evaluator never generates any.
+template<EvalTier Tier>
+int Evaluation::evaluateTerms(const Board& board) const {
+    int score = materialAndPositionValue(board) + pawnStructureValue(board);
+    if (Tier == FULL_TIER) {
+        score += mobilityValue(board);
+        score += kingSafetyValue(board);
     }
-    return score;
+
+    return (board.getTurn() == WHITE) ? score : -score;
+}
+
+void Evaluation::setLazyMargin(int margin) {
+    lazyMarginValue = std::max(0, margin);
+}
+
+int Evaluation::lazyMargin() {
+    return lazyMarginValue;
+}
+
+Evaluation::LazyStats& Evaluation::lazyStats() {
+    thread_local LazyStats stats = {0, 0};
+    return stats;
+}
+
+int Evaluation::pieceValue(PieceType type) const {
+    return PSQT::PIECE_VALUE[type];
+}
+
+// Board keeps both sums up to date in make/unmake; they are blended by how
+// much non-pawn material is left, so the king walks to the center gradually
+// instead of at a single material threshold.
+int Evaluation::materialAndPositionValue(const Board& board) const {
+    int phase = std::min(board.gamePhase(), PSQT::MAX_PHASE);
+    return (board.midgameScore() * phase + board.endgameScore() * (PSQT::MAX_PHASE - phase)) / PSQT::MAX_PHASE;
 }
 
+// Squares each piece attacks that are neither occupied by its own side nor
+// covered by an enemy pawn, weighted per piece type. Minor pieces count three
+// times as much as the major pieces, as they did when moves were counted.
 int Evaluation::mobilityValue(const Board& board) const {
-    MoveGenerator moveGen;
-    int whiteMobility = 0;
-    int blackMobility = 0;
-    
-    Board whiteToMove = board;
-    Board blackToMove = board;
-    
-    whiteToMove.setTurn(WHITE);
-    blackToMove.setTurn(BLACK);
-    
-    std::vector<Move> whiteMoves = moveGen.generateLegalMoves(whiteToMove);
-    std::vector<Move> blackMoves = moveGen.generateLegalMoves(blackToMove);
-    
-    whiteMobility = whiteMoves.size();
-    blackMobility = blackMoves.size();
-    
-    for (const Move& move : whiteMoves) {
-        Piece piece = board.getPieceAt(move.startRow, move.startCol);
-        if (piece.type == BISHOP || piece.type == KNIGHT) {
-            whiteMobility += 2;
-        }
-    }
-    
-    for (const Move& move : blackMoves) {
-        Piece piece = board.getPieceAt(move.startRow, move.startCol);
-        if (piece.type == BISHOP || piece.type == KNIGHT) {
-            blackMobility += 2;
+    static const int MOBILITY_WEIGHT[6] = {0, 15, 15, 5, 5, 0};
+
+    const PawnEntry& pawns = PawnTable::forThread().probe(board);
+    Bitboard safe[2] = {~board.occupancy(WHITE) & ~pawns.pawnAttacks[BLACK],
+                        ~board.occupancy(BLACK) & ~pawns.pawnAttacks[WHITE]};
+    int mobility[2] = {0, 0};
+    for (int color = WHITE; color <= BLACK; ++color) {
+        for (int type = KNIGHT; type <= QUEEN; ++type) {
+            Bitboard pieces = board.pieces(static_cast<PieceColor>(color), static_cast<PieceType>(type));
+            while (pieces) {
+                Bitboard attacks = Attacks::attacksFrom(static_cast<PieceType>(type), static_cast<PieceColor>(color),
+                                                        popLsb(pieces), board.occupancy());
+                mobility[color] += popCount(attacks & safe[color]) * MOBILITY_WEIGHT[type];
+            }
         }
     }
-    
-    return (whiteMobility - blackMobility) * 5;
+
+    return mobility[WHITE] - mobility[BLACK];
 }
 
 int Evaluation::pawnStructureValue(const Board& board) const {
-    int score = 0;
-    
-    bool whitePawns[8] = {false};
-    bool blackPawns[8] = {false};
-    
-    int whiteDoubledPawns = 0;
-    int blackDoubledPawns = 0;
-    int whiteIsolatedPawns = 0;
-    int blackIsolatedPawns = 0;
-    int whitePassedPawns = 0;
-    int blackPassedPawns = 0;
-    
-    for (int col = 0; col < 8; ++col) {
-        int whitePawnsInCol = 0;
-        int blackPawnsInCol = 0;
-        
-        for (int row = 0; row < 8; ++row) {
-            Piece piece = board.getPieceAt(row, col);
-            if (piece.type == PAWN) {
-                if (piece.color == WHITE) {
-                    whitePawns[col] = true;
-                    whitePawnsInCol++;
-                } else {
-                    blackPawns[col] = true;
-                    blackPawnsInCol++;
-                }
-            }
-        }
-        
-        if (whitePawnsInCol > 1) whiteDoubledPawns += whitePawnsInCol - 1;
-        if (blackPawnsInCol > 1) blackDoubledPawns += blackPawnsInCol - 1;
-    }
-    
-    for (int col = 0; col < 8; ++col) {
-        if (!whitePawns[col] && !blackPawns[col]) continue;
-        
-        bool whiteIsolated = whitePawns[col] && 
-                            (col == 0 || !whitePawns[col-1]) && 
-                            (col == 7 || !whitePawns[col+1]);
-        bool blackIsolated = blackPawns[col] && 
-                            (col == 0 || !blackPawns[col-1]) && 
-                            (col == 7 || !blackPawns[col+1]);
-        
-        if (whiteIsolated) whiteIsolatedPawns++;
-        if (blackIsolated) blackIsolatedPawns++;
-        
-        int mostAdvancedWhitePawn = 8;
-        int mostAdvancedBlackPawn = -1;
-        
-        for (int row = 0; row < 8; ++row) {
-            Piece piece = board.getPieceAt(row, col);
-            if (piece.type == PAWN) {
-                if (piece.color == WHITE && row < mostAdvancedWhitePawn) {
-                    mostAdvancedWhitePawn = row;
-                } else if (piece.color == BLACK && row > mostAdvancedBlackPawn) {
-                    mostAdvancedBlackPawn = row;
-                }
-            }
-        }
-        
-        if (mostAdvancedWhitePawn < 8) {
-            bool passed = true;
-            
-            for (int c = col-1; c <= col+1; c++) {
-                if (c < 0 || c > 7) continue;
-                
-                for (int r = 0; r < mostAdvancedWhitePawn; r++) {
-                    Piece piece = board.getPieceAt(r, c);
-                    if (piece.type == PAWN && piece.color == BLACK) {
-                        passed = false;
-                        break;
-                    }
-                }
-                if (!passed) break;
-            }
-            
-            if (passed) whitePassedPawns++;
-        }
-        
-        if (mostAdvancedBlackPawn >= 0) {
-            bool passed = true;
-            
-            for (int c = col-1; c <= col+1; c++) {
-                if (c < 0 || c > 7) continue;
-                
-                for (int r = 7; r > mostAdvancedBlackPawn; r--) {
-                    Piece piece = board.getPieceAt(r, c);
-                    if (piece.type == PAWN && piece.color == WHITE) {
-                        passed = false;
-                        break;
-                    }
-                }
-                if (!passed) break;
-            }
-            
-            if (passed) blackPassedPawns++;
-        }
-    }
-    
-    score -= whiteDoubledPawns * 20;
-    score += blackDoubledPawns * 20;
-    score -= whiteIsolatedPawns * 15;
-    score += blackIsolatedPawns * 15;
-    score += whitePassedPawns * 30;
-    score -= blackPassedPawns * 30;
-    
-    return score;
+    return PawnTable::forThread().probe(board).score;
 }
 
 int Evaluation::kingSafetyValue(const Board& board) const {
@@ -280,20 +161,3 @@ int Evaluation::kingSafetyValue(const Board& board) const {
     
     return score;
 }
-
-bool Evaluation::isEndgame(const Board& board) const {
-    int pieceCount = 0;
-    bool hasQueen = false;
-    
-    for (int row = 0; row < 8; ++row) {
-        for (int col = 0; col < 8; ++col) {
-            Piece piece = board.getPieceAt(row, col);
-            if (!piece.isEmpty() && piece.type != KING && piece.type != PAWN) {
-                pieceCount++;
-                if (piece.type == QUEEN) hasQueen = true;
-            }
-        }
-    }
-    
-    return pieceCount <= 6 || !hasQueen;
-}
\ No newline at end of file
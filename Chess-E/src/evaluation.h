@@ -1,22 +1,55 @@
 #pragma once
 
 #include "board.h"
+#include <cstdint>
+
+// MATERIAL_TIER is material, piece-square tables and the cached pawn
+// structure: a few table lookups. FULL_TIER adds mobility and king safety.
+enum EvalTier {
+    MATERIAL_TIER, FULL_TIER
+};
 
 class Evaluation {
 public:
     Evaluation();
+    // Served from the thread's EvalCache when the position was seen before.
     int evaluate(const Board& board) const;
+    // As above, but when the material tier is already further than the lazy
+    // margin outside [alpha, beta] that estimate is returned instead; the
+    // skipped terms could not bring the score back into the window.
+    int evaluate(const Board& board, int alpha, int beta) const;
+    // The network when NNUE is enabled, the hand-written terms otherwise.
+    int evaluateUncached(const Board& board) const;
+    int evaluateClassical(const Board& board) const;
 
     static const int CHECKMATE_VALUE = 10000;
     static const int INFINITY_VALUE = 100000;
     static const int VALUE_UNKNOWN = -INFINITY_VALUE;
+    static const int MAX_PLY = 128;
+    static const int MATE_IN_MAX_PLY = CHECKMATE_VALUE - MAX_PLY;
 
     int pieceValue(PieceType type) const;
-    int pieceSquareBonus(PieceType type, PieceColor color, int row, int col, const Board& board) const;
-    int materialValue(const Board& board) const;
-    int positionValue(const Board& board) const;
+    int materialAndPositionValue(const Board& board) const;
     int mobilityValue(const Board& board) const;
     int pawnStructureValue(const Board& board) const;
     int kingSafetyValue(const Board& board) const;
-    bool isEndgame(const Board& board) const;
+
+    // How far outside the window the material tier must be to stop there.
+    // Zero disables the early exit.
+    static const int DEFAULT_LAZY_MARGIN = 400;
+    static void setLazyMargin(int margin);
+    static int lazyMargin();
+
+    // Counters of the calling thread, for the search's info output.
+    struct LazyStats {
+        std::uint64_t evaluations;
+        std::uint64_t lazyExits;
+
+        double skipRate() const { return evaluations ? 100.0 * lazyExits / evaluations : 0.0; }
+    };
+    static LazyStats& lazyStats();
+
+private:
+    template<EvalTier Tier>
+    int evaluateTerms(const Board& board) const;
 };
\ No newline at end of file
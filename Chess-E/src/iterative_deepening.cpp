@@ -2,15 +2,19 @@
 #include <iostream>
 #include <algorithm>
 
-IterativeDeepening::IterativeDeepening() :
-    searchEngine(),
-    bestMoveFound(Move(-1,-1,-1,-1)),
+IterativeDeepening::IterativeDeepening(TranspositionTable& table, int threadIndex,
+                                       const std::atomic<bool>* stopSignal) :
+    searchEngine(table),
+    threadIndex(threadIndex),
+    stopSignal(stopSignal),
+    bestMoveFound(Move()),
     bestScoreFound(Evaluation::VALUE_UNKNOWN),
     currentDepth(0),
     timeLimit(std::chrono::seconds(5)),
-    stopSearch(false),
-    lastSearchInfo({0, 0, std::chrono::milliseconds(0), Move(-1,-1,-1,-1), Evaluation::VALUE_UNKNOWN})
+    lastSearchInfo({0, 0, std::chrono::milliseconds(0), Move(), Evaluation::VALUE_UNKNOWN}),
+    searching(false)
 {
+    searchEngine.setStopSignal(stopSignal);
 }
 
 Move IterativeDeepening::getBestMove() const {
@@ -23,10 +27,12 @@ IterativeDeepening::SearchInfo IterativeDeepening::getSearchInfo() const {
 
 
 void IterativeDeepening::startSearch(Board& board, int maxDepth, std::chrono::milliseconds timeLimit) {
+    searching = true;
     startTime = std::chrono::steady_clock::now();
     this->timeLimit = timeLimit;
-    stopSearch = false;
-    bestMoveFound = Move(-1, -1, -1, -1); 
+    currentDepth = 0;
+    searchEngine.resetNodes();
+    bestMoveFound = Move(); 
     bestScoreFound = Evaluation::VALUE_UNKNOWN;
 
     iterativeSearch(board, maxDepth);
@@ -35,57 +41,46 @@ void IterativeDeepening::startSearch(Board& board, int maxDepth, std::chrono::mi
     lastSearchInfo.bestScore = bestScoreFound;
     lastSearchInfo.timeElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
     lastSearchInfo.depthSearched = currentDepth;
-    lastSearchInfo.nodesEvaluated = 0; 
+    lastSearchInfo.nodesEvaluated = searchEngine.getNodes();
+    searching = false;
 }
 
 
 void IterativeDeepening::iterativeSearch(Board& board, int maxDepth) {
-    for (int depth = 1; depth <= maxDepth; ++depth) {
+    // Odd helpers start one ply deeper, so at any moment the threads are
+    // spread over two depths instead of all repeating the same iteration.
+    int firstDepth = 1 + threadIndex % 2;
+    for (int depth = firstDepth; depth <= maxDepth; ++depth) {
+        if (isTimeExpired() || isStopped()) break;
+
+        Move iterationBest;
+        int score = searchEngine.searchRoot(board, depth, bestScoreFound, iterationBest);
+        if (isStopped()) break;
         currentDepth = depth;
-        if (isTimeExpired() || stopSearch) break;
-
-        int score = searchEngine.alphaBeta(board, depth, -Evaluation::INFINITY_VALUE, Evaluation::INFINITY_VALUE);
-        
-        Move ttBestMove = searchEngine.getTranspositionTable().getBestMove(board);
-        
-        if (ttBestMove.startRow != -1) {
-            bestMoveFound = ttBestMove;
-        } else {
-            std::vector<Move> legalMoves = MoveGenerator().generateLegalMoves(board);
-            if (!legalMoves.empty()) {
-                Board testBoard = board;
-                int bestScore = -Evaluation::INFINITY_VALUE;
-                
-                for (const auto& move : legalMoves) {
-                    Board nextBoard = board;
-                    nextBoard.movePiece(move.startRow, move.startCol, move.endRow, move.endCol);
-                    nextBoard.switchTurn();
-                    
-                    int moveScore = -searchEngine.alphaBeta(nextBoard, 1, -Evaluation::INFINITY_VALUE, -bestScore);
-                    
-                    if (moveScore > bestScore) {
-                        bestScore = moveScore;
-                        bestMoveFound = move;
-                    }
-                }
-            }
+
+        if (isHelper()) {
+            bestScoreFound = score;
+            if (std::abs(score) >= Evaluation::MATE_IN_MAX_PLY) break;
+            continue;
+        }
+
+        // The root move comes from this thread's own search: the shared table
+        // may already hold a helper's entry for the root, from another depth
+        // or a failed aspiration window.
+        if (iterationBest.isValid()) {
+            bestMoveFound = iterationBest;
         }
-        
+
         bestScoreFound = score; 
 
-        std::cout << "Depth " << depth << " score: " << score << " move: ";
-        if (bestMoveFound.startRow != -1) {
-            char startFile = 'a' + bestMoveFound.startCol;
-            int startRank = 8 - bestMoveFound.startRow;
-            char endFile = 'a' + bestMoveFound.endCol;
-            int endRank = 8 - bestMoveFound.endRow;
-            std::cout << startFile << startRank << endFile << endRank;
-        } else {
-            std::cout << "None";
+        std::cout << "info depth " << depth << " score cp " << score
+                  << " hashfull " << searchEngine.getTranspositionTable().hashfull();
+        if (bestMoveFound.isValid()) {
+            std::cout << " pv " << bestMoveFound.toString();
         }
         std::cout << std::endl;
 
-        if (std::abs(score) > Evaluation::CHECKMATE_VALUE - maxDepth) {
+        if (std::abs(score) >= Evaluation::MATE_IN_MAX_PLY) {
             break;
         }
     }
@@ -94,4 +89,8 @@ void IterativeDeepening::iterativeSearch(Board& board, int maxDepth) {
 
 bool IterativeDeepening::isTimeExpired() const {
     return std::chrono::steady_clock::now() - startTime > timeLimit;
+}
+
+bool IterativeDeepening::isStopped() const {
+    return stopSignal && stopSignal->load(std::memory_order_relaxed);
 }
\ No newline at end of file
@@ -7,36 +7,47 @@
 #include <chrono>
 #include <vector>
 #include <atomic>
+#include <cstdint>
 
 class Search;
 
 class IterativeDeepening {
 public:
-    IterativeDeepening();
+    // Thread 0 is the main search, which reports and picks the move. Helper
+    // threads search silently, only to fill the shared table, and give up
+    // mid-iteration as soon as the stop signal is raised.
+    explicit IterativeDeepening(TranspositionTable& table, int threadIndex = 0,
+                                const std::atomic<bool>* stopSignal = nullptr);
     Move getBestMove() const;
     void startSearch(Board& board, int maxDepth, std::chrono::milliseconds timeLimit);
     struct SearchInfo {
         int depthSearched;
-        int nodesEvaluated;
+        std::uint64_t nodesEvaluated;
         std::chrono::milliseconds timeElapsed;
         Move bestMove;
         int bestScore;
     };
     SearchInfo getSearchInfo() const;
+    bool isSearching() const { return searching.load(); }
+    void clearHeuristics() { searchEngine.clearHeuristics(); }
 
 
 private:
     AlphaBetaSearch searchEngine;
+    int threadIndex;
+    const std::atomic<bool>* stopSignal;
     Move bestMoveFound;
     int bestScoreFound;
-    int currentDepth;
+    int currentDepth;  // the last completed iteration
     std::chrono::milliseconds timeLimit;
     std::chrono::time_point<std::chrono::steady_clock> startTime;
-    std::atomic<bool> stopSearch;
     SearchInfo lastSearchInfo;
+    std::atomic<bool> searching;
 
     void iterativeSearch(Board& board, int maxDepth);
     bool isTimeExpired() const;
+    bool isStopped() const;
+    bool isHelper() const { return threadIndex > 0; }
 };
 
 #endif 
\ No newline at end of file
@@ -1,53 +1,74 @@
 #pragma once
 
 #include "board.h"
+#include <cstdint>
 #include <string>
 
+enum MoveType {
+    NORMAL, PROMOTION, EN_PASSANT, CASTLING
+};
+
+// A move packed into 16 bits:
+//   bits 0-5   origin square (row * 8 + col)
+//   bits 6-11  destination square
+//   bits 12-13 promotion piece minus KNIGHT
+//   bits 14-15 MoveType
+// Castling is encoded as the king's two-square step. The all-zero value
+// (a8 to a8) is never a real move and serves as "no move".
 struct Move {
-    int startRow;
-    int startCol;
-    int endRow;
-    int endCol;
-    PieceType promotionPiece;
-    bool isCapture;
-    bool isCastling;
-    bool isEnPassant;
-    
-    Move(int sr = -1, int sc = -1, int er = -1, int ec = -1) 
-        : startRow(sr), startCol(sc), endRow(er), endCol(ec),
-          promotionPiece(EMPTY), isCapture(false), isCastling(false), isEnPassant(false) {}
-    
-    bool operator==(const Move& other) const {
-        return startRow == other.startRow && startCol == other.startCol &&
-               endRow == other.endRow && endCol == other.endCol;
+    constexpr Move() : data(0) {}
+
+    constexpr Move(int from, int to, MoveType type = NORMAL, PieceType promotion = KNIGHT)
+        : data(static_cast<std::uint16_t>(from | (to << 6) | ((promotion - KNIGHT) << 12) | (type << 14))) {}
+
+    constexpr Move(int startRow, int startCol, int endRow, int endCol)
+        : Move(makeSquare(startRow, startCol), makeSquare(endRow, endCol)) {}
+
+    static constexpr Move fromRaw(std::uint16_t raw) {
+        Move move;
+        move.data = raw;
+        return move;
     }
-    
-    bool isValid() const {
-        return startRow >= 0 && startRow < 8 && startCol >= 0 && startCol < 8 &&
-               endRow >= 0 && endRow < 8 && endCol >= 0 && endCol < 8;
+
+    constexpr std::uint16_t raw() const { return data; }
+
+    constexpr int from() const { return data & 0x3F; }
+    constexpr int to() const { return (data >> 6) & 0x3F; }
+    constexpr MoveType type() const { return static_cast<MoveType>(data >> 14); }
+
+    constexpr PieceType promotionPiece() const {
+        return type() == PROMOTION ? static_cast<PieceType>(((data >> 12) & 3) + KNIGHT) : EMPTY;
     }
-    
+
+    constexpr int startRow() const { return squareRow(from()); }
+    constexpr int startCol() const { return squareCol(from()); }
+    constexpr int endRow() const { return squareRow(to()); }
+    constexpr int endCol() const { return squareCol(to()); }
+
+    constexpr bool isValid() const { return from() != to(); }
+
+    constexpr bool operator==(const Move& other) const { return data == other.data; }
+    constexpr bool operator!=(const Move& other) const { return data != other.data; }
+
+    // Long algebraic (UCI) notation, e.g. "e2e4" or "e7e8q".
     std::string toString() const {
         if (!isValid()) return "Invalid";
-        
+
         std::string result;
-        result += char('a' + startCol);
-        result += char('8' - startRow);
-        result += char('a' + endCol);
-        result += char('8' - endRow);
-        
-        if (promotionPiece != EMPTY) {
-            char promChar = 'q';
-            switch (promotionPiece) {
-                case KNIGHT: promChar = 'n'; break;
-                case BISHOP: promChar = 'b'; break;
-                case ROOK: promChar = 'r'; break;
-                case QUEEN: promChar = 'q'; break;
-                default: break;
-            }
-            result += promChar;
+        result += char('a' + startCol());
+        result += char('8' - startRow());
+        result += char('a' + endCol());
+        result += char('8' - endRow());
+
+        if (type() == PROMOTION) {
+            result += "nbrq"[promotionPiece() - KNIGHT];
         }
-        
+
         return result;
     }
-}; 
\ No newline at end of file
+
+private:
+    std::uint16_t data;
+};
+
+static_assert(sizeof(Move) == 2, "Move must stay a packed 16-bit value");
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "move.h"
+#include <cstddef>
+#include <utility>
+
+// No legal chess position has more than 218 moves, so a fixed inline array
+// is always large enough and a list never touches the heap.
+const int MAX_MOVES = 256;
+
+class MoveList {
+public:
+    MoveList() : count(0) {}
+
+    void push_back(const Move& move) { moves[count++] = move; }
+    void clear() { count = 0; }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Move& operator[](std::size_t index) { return moves[index]; }
+    const Move& operator[](std::size_t index) const { return moves[index]; }
+
+    Move* begin() { return moves; }
+    Move* end() { return moves + count; }
+    const Move* begin() const { return moves; }
+    const Move* end() const { return moves + count; }
+
+    bool contains(const Move& move) const {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (moves[i] == move) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    Move moves[MAX_MOVES];
+    std::size_t count;
+};
+
+struct ScoredMove {
+    Move move;
+    int score;
+};
+
+// Same storage model as MoveList with an ordering score next to each move.
+class ScoredMoveList {
+public:
+    ScoredMoveList() : count(0) {}
+
+    void push_back(const Move& move, int score) {
+        moves[count].move = move;
+        moves[count].score = score;
+        count++;
+    }
+    void clear() { count = 0; }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    ScoredMove& operator[](std::size_t index) { return moves[index]; }
+    const ScoredMove& operator[](std::size_t index) const { return moves[index]; }
+
+    ScoredMove* begin() { return moves; }
+    ScoredMove* end() { return moves + count; }
+    const ScoredMove* begin() const { return moves; }
+    const ScoredMove* end() const { return moves + count; }
+
+    // Selection step: swaps the best of the moves from index on into index
+    // and returns it. Calling it for 0, 1, 2, ... yields the moves best
+    // first, and a node that stops early never orders the rest.
+    Move pickBest(std::size_t index) {
+        std::size_t best = index;
+        for (std::size_t i = index + 1; i < count; ++i) {
+            if (moves[i].score > moves[best].score) {
+                best = i;
+            }
+        }
+        std::swap(moves[index], moves[best]);
+        return moves[index].move;
+    }
+
+private:
+    ScoredMove moves[MAX_MOVES];
+    std::size_t count;
+};
@@ -1,27 +1,126 @@
 #include "move_ordering.h"
+#include "psqt.h"
 #include <algorithm>
+#include <cstdlib>
 
-MoveOrdering::MoveOrdering() {}
+namespace {
 
-void MoveOrdering::orderMoves(const Board& board, std::vector<Move>& moves) {
-    std::sort(moves.begin(), moves.end(), [&](const Move& a, const Move& b) {
-        return getMoveScore(board, a) > getMoveScore(board, b);
-    });
+const int CONTINUATION_SIZE = 12 * 64 * 12 * 64;
+
+int pieceIndex(int code) {
+    return (code & 7) + 6 * (code >> 3);
 }
 
-int MoveOrdering::getMoveScore(const Board& board, const Move& move) {
-    int score = 0;
+template<typename T>
+void applyBonus(T& entry, int bonus, int limit) {
+    entry = static_cast<T>(entry + bonus - entry * std::abs(bonus) / limit);
+}
+
+}
 
-    Piece capturedPiece = board.getPieceAt(move.endRow, move.endCol);
-    if (!capturedPiece.isEmpty()) {
-        score += Evaluation().pieceValue(capturedPiece.type) - Evaluation().pieceValue(board.getPieceAt(move.startRow, move.startCol).type)/10; // MVV-LVA
+MoveOrdering::MoveOrdering() : continuationHistory(new std::int16_t[CONTINUATION_SIZE]) {
+    clear();
+}
+
+void MoveOrdering::clear() {
+    for (auto& pair : killers) {
+        pair[0] = pair[1] = Move();
+    }
+    for (auto& byColor : history) {
+        for (auto& byFrom : byColor) {
+            for (int& score : byFrom) {
+                score = 0;
+            }
+        }
+    }
+    for (auto& byPiece : counterMoves) {
+        for (Move& move : byPiece) {
+            move = Move();
+        }
     }
+    std::fill(continuationHistory.get(), continuationHistory.get() + CONTINUATION_SIZE, 0);
+}
+
+bool MoveOrdering::isQuiet(const Board& board, const Move& move) {
+    return move.type() != PROMOTION && move.type() != EN_PASSANT &&
+           board.getPieceAt(move.endRow(), move.endCol()).isEmpty();
+}
+
+// MVV-LVA, with promotions ranked by the piece they create.
+int MoveOrdering::captureScore(const Board& board, const Move& move) {
+    PieceType victim = (move.type() == EN_PASSANT) ? PAWN : board.getPieceAt(move.endRow(), move.endCol()).type;
+    int score = 0;
+    if (victim != EMPTY) {
+        score += PSQT::PIECE_VALUE[victim] - PSQT::PIECE_VALUE[board.getPieceAt(move.startRow(), move.startCol()).type] / 10;
+    }
+    if (move.type() == PROMOTION) {
+        score += PSQT::PIECE_VALUE[move.promotionPiece()];
+    }
+    return score;
+}
 
-    if (board.isKingInCheck(board.getTurn())) score += 100; 
+void MoveOrdering::updateKillers(const Move& move, int ply) {
+    if (ply >= Evaluation::MAX_PLY || killers[ply][0] == move) {
+        return;
+    }
+    killers[ply][1] = killers[ply][0];
+    killers[ply][0] = move;
+}
 
-    if (board.getPieceAt(move.startRow, move.startCol).type == PAWN && (move.endRow == 0 || move.endRow == 7)) {
-        score += 900; 
+// The row of the continuation table that follows the move made pliesAgo
+// plies back, or null if there is no such move.
+std::int16_t* MoveOrdering::continuationEntries(const Board& board, int pliesAgo) const {
+    int piece, to;
+    if (!board.previousMove(pliesAgo, piece, to)) {
+        return nullptr;
     }
+    return continuationHistory.get() + (pieceIndex(piece) * 64 + to) * PIECE_INDICES * 64;
+}
 
+int MoveOrdering::quietScore(const Board& board, const Move& move) const {
+    int score = history[board.getTurn()][move.from()][move.to()];
+    int piece = pieceIndex(board.getPieceAt(move.startRow(), move.startCol()).type | board.getTurn() << 3);
+    for (int pliesAgo = 1; pliesAgo <= 2; ++pliesAgo) {
+        if (const std::int16_t* entries = continuationEntries(board, pliesAgo)) {
+            score += entries[piece * 64 + move.to()];
+        }
+    }
     return score;
-}
\ No newline at end of file
+}
+
+Move MoveOrdering::getCounterMove(const Board& board) const {
+    int piece, to;
+    return board.previousMove(1, piece, to) ? counterMoves[pieceIndex(piece)][to] : Move();
+}
+
+void MoveOrdering::updateQuietStats(const Board& board, const Move& best, const MoveList& tried, int ply, int depth) {
+    updateKillers(best, ply);
+
+    int piece, to;
+    if (board.previousMove(1, piece, to)) {
+        counterMoves[pieceIndex(piece)][to] = best;
+    }
+
+    int bonus = std::min(32 * depth * depth, 1536);
+    PieceColor us = board.getTurn();
+    std::int16_t* continuations[2] = {continuationEntries(board, 1), continuationEntries(board, 2)};
+    auto update = [&](const Move& move, int amount) {
+        applyBonus(history[us][move.from()][move.to()], amount, HISTORY_MAX);
+        int moved = pieceIndex(board.getPieceAt(move.startRow(), move.startCol()).type | us << 3);
+        for (std::int16_t* entries : continuations) {
+            if (entries) {
+                applyBonus(entries[moved * 64 + move.to()], amount, HISTORY_MAX);
+            }
+        }
+    };
+
+    update(best, bonus);
+    for (const Move& move : tried) {
+        update(move, -bonus);
+    }
+}
+
+const Move* MoveOrdering::getKillers(int ply) const {
+    static const Move noKillers[2] = {Move(), Move()};
+    return ply < Evaluation::MAX_PLY ? killers[ply] : noKillers;
+}
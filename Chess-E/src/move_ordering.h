@@ -4,15 +4,49 @@
 #include "board.h"
 #include "move.h"
 #include "evaluation.h"
-#include <vector>
+#include "move_list.h"
+#include <cstdint>
+#include <memory>
 
 class MoveOrdering {
 public:
     MoveOrdering();
-    void orderMoves(const Board& board, std::vector<Move>& moves);
+
+    // Quiet moves neither capture nor promote; only they feed the killer
+    // and history tables.
+    static bool isQuiet(const Board& board, const Move& move);
+    static int captureScore(const Board& board, const Move& move);
+
+    // Ordering score of a quiet move: its butterfly history plus the
+    // continuation history following the last move and the one before it.
+    int quietScore(const Board& board, const Move& move) const;
+    // The quiet move that last refuted the opponent's previous move.
+    Move getCounterMove(const Board& board) const;
+    const Move* getKillers(int ply) const;
+    int getHistory(PieceColor color, const Move& move) const { return history[color][move.from()][move.to()]; }
+
+    // The quiet move best caused a cutoff at this node after the quiet moves
+    // in tried had failed to. best becomes a killer and the counter move, is
+    // rewarded in every history table, and the tried moves are penalized.
+    void updateQuietStats(const Board& board, const Move& best, const MoveList& tried, int ply, int depth);
+    void clear();
 
 private:
-    int getMoveScore(const Board& board, const Move& move); 
+    // Every history entry stays within +-HISTORY_MAX: updates shrink as an
+    // entry approaches the bound instead of being rescaled all at once.
+    static const int HISTORY_MAX = 16384;
+    // Pieces of both colors, indexed color * 6 + type.
+    static const int PIECE_INDICES = 12;
+
+    Move killers[Evaluation::MAX_PLY][2];
+    int history[2][64][64];
+    Move counterMoves[PIECE_INDICES][64];
+    // [previous piece][previous destination][piece][destination], shared by
+    // the one- and two-ply lookups. About 1 MB, so it lives on the heap.
+    std::unique_ptr<std::int16_t[]> continuationHistory;
+
+    void updateKillers(const Move& move, int ply);
+    std::int16_t* continuationEntries(const Board& board, int pliesAgo) const;
 };
 
-#endif 
\ No newline at end of file
+#endif
@@ -0,0 +1,109 @@
+#include "move_picker.h"
+#include "see.h"
+
+MovePicker::MovePicker(const Board& board, const Move& ttMove, int ply, const MoveOrdering& ordering) :
+    board(board),
+    ordering(ordering),
+    ttMove(ttMove),
+    stage(TT_MOVE),
+    current(0)
+{
+    const Move* plyKillers = ordering.getKillers(ply);
+    killers[0] = plyKillers[0];
+    killers[1] = plyKillers[1];
+    counterMove = ordering.getCounterMove(board);
+}
+
+Move MovePicker::nextMove() {
+    switch (stage) {
+        case TT_MOVE:
+            stage = INIT_CAPTURES;
+            if (isUsable(ttMove)) {
+                return ttMove;
+            }
+            // fall through
+        case INIT_CAPTURES: {
+            MoveList moves;
+            moveGenerator.generate<CAPTURES>(board, moves);
+            for (const Move& move : moves) {
+                captures.push_back(move, ordering.captureScore(board, move));
+            }
+            current = 0;
+            stage = GOOD_CAPTURES;
+        }
+            // fall through
+        case GOOD_CAPTURES:
+            while (current < captures.size()) {
+                Move move = captures.pickBest(current++);
+                if (move == ttMove) {
+                    continue;
+                }
+                if (!isGoodCapture(move)) {
+                    badCaptures.push_back(move);
+                    continue;
+                }
+                return move;
+            }
+            current = 0;
+            stage = KILLERS;
+            // fall through
+        case KILLERS:
+            while (current < 2) {
+                const Move& killer = killers[current++];
+                if (killer != ttMove && MoveOrdering::isQuiet(board, killer) && isUsable(killer)) {
+                    return killer;
+                }
+                // Not searched here, so it must not be skipped among the quiets.
+                killers[current - 1] = Move();
+            }
+            stage = COUNTER_MOVE;
+            // fall through
+        case COUNTER_MOVE:
+            stage = INIT_QUIETS;
+            if (counterMove != ttMove && counterMove != killers[0] && counterMove != killers[1] &&
+                MoveOrdering::isQuiet(board, counterMove) && isUsable(counterMove)) {
+                return counterMove;
+            }
+            counterMove = Move();
+            // fall through
+        case INIT_QUIETS: {
+            MoveList moves;
+            moveGenerator.generate<QUIETS>(board, moves);
+            for (const Move& move : moves) {
+                quiets.push_back(move, ordering.quietScore(board, move));
+            }
+            current = 0;
+            stage = QUIET_MOVES;
+        }
+            // fall through
+        case QUIET_MOVES:
+            while (current < quiets.size()) {
+                Move move = quiets.pickBest(current++);
+                if (move != ttMove && move != killers[0] && move != killers[1] && move != counterMove) {
+                    return move;
+                }
+            }
+            current = 0;
+            stage = BAD_CAPTURES;
+            // fall through
+        case BAD_CAPTURES:
+            if (current < badCaptures.size()) {
+                return badCaptures[current++];
+            }
+            stage = DONE;
+            // fall through
+        default:
+            return Move();
+    }
+}
+
+// Hash and killer moves come from other positions, so they are checked
+// against this one before being searched.
+bool MovePicker::isUsable(const Move& move) const {
+    return moveGenerator.isPseudoLegal(board, move) && moveGenerator.isLegal(board, move);
+}
+
+// Captures that lose material in the exchange wait until after the quiets.
+bool MovePicker::isGoodCapture(const Move& move) const {
+    return SEE::evaluate(board, move) >= 0;
+}
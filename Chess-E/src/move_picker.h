@@ -0,0 +1,42 @@
+#pragma once
+
+#include "board.h"
+#include "move.h"
+#include "move_list.h"
+#include "move_ordering.h"
+#include "movegen.h"
+
+// Hands out the moves of a node one at a time, generating each stage only
+// when the previous one is used up: hash move, captures that do not lose
+// material by SEE (in MVV-LVA order), killers, the counter move, quiets by
+// history, then the losing captures. A node that cuts off early never generates or sorts the
+// moves it would not have tried.
+class MovePicker {
+public:
+    MovePicker(const Board& board, const Move& ttMove, int ply, const MoveOrdering& ordering);
+
+    // Returns the null move once every legal move has been handed out.
+    Move nextMove();
+
+private:
+    enum Stage {
+        TT_MOVE, INIT_CAPTURES, GOOD_CAPTURES, KILLERS, COUNTER_MOVE, INIT_QUIETS, QUIET_MOVES, BAD_CAPTURES, DONE
+    };
+
+    const Board& board;
+    const MoveOrdering& ordering;
+    MoveGenerator moveGenerator;
+
+    Move ttMove;
+    Move killers[2];
+    Move counterMove;
+    int stage;
+    std::size_t current;
+
+    ScoredMoveList captures;
+    ScoredMoveList quiets;
+    MoveList badCaptures;
+
+    bool isUsable(const Move& move) const;
+    bool isGoodCapture(const Move& move) const;
+};
@@ -1,175 +1,319 @@
 #include "movegen.h"
+#include "attacks.h"
 
-std::vector<Move> MoveGenerator::generateLegalMoves(const Board& board) const {
-    std::vector<Move> pseudoLegalMoves = generatePseudoLegalMoves(board);
-    std::vector<Move> legalMoves;
+namespace {
 
-    for (const auto& move : pseudoLegalMoves) {
-        if (isMoveLegal(board, move)) {
-            legalMoves.push_back(move);
+// Adds one move per destination bit, the origin being Offset squares back.
+template<int Offset>
+void addShiftedMoves(Bitboard targets, MoveList& moves) {
+    while (targets) {
+        int to = popLsb(targets);
+        moves.push_back(Move(to - Offset, to));
+    }
+}
+
+template<int Offset>
+void addPromotions(Bitboard targets, MoveList& moves) {
+    while (targets) {
+        int to = popLsb(targets);
+        for (PieceType promotion : {QUEEN, KNIGHT, ROOK, BISHOP}) {
+            moves.push_back(Move(to - Offset, to, PROMOTION, promotion));
         }
     }
-    return legalMoves;
 }
 
-std::vector<Move> MoveGenerator::generatePseudoLegalMoves(const Board& board) const {
-    std::vector<Move> moves;
-    PieceColor turn = board.getTurn();
+}
 
-    for (int row = 0; row < 8; ++row) {
-        for (int col = 0; col < 8; ++col) {
-            Piece piece = board.getPieceAt(row, col);
-            if (piece.color == turn) {
-                std::vector<Move> pieceMoves;
-                switch (piece.type) {
-                    case PAWN:   pieceMoves = generatePawnMoves(board, row, col);   break;
-                    case KNIGHT: pieceMoves = generateKnightMoves(board, row, col); break;
-                    case BISHOP: pieceMoves = generateBishopMoves(board, row, col); break;
-                    case ROOK:   pieceMoves = generateRookMoves(board, row, col);   break;
-                    case QUEEN:  pieceMoves = generateQueenMoves(board, row, col);  break;
-                    case KING:  pieceMoves = generateKingMoves(board, row, col);   break;
-                    default: break;
-                }
-                moves.insert(moves.end(), pieceMoves.begin(), pieceMoves.end());
-            }
+// Checkers and pinned pieces are computed once, so every emitted move is
+// legal without making it: in check, non-king moves must capture the checker
+// or block its ray; pinned pieces stay on the line through their king; the
+// king only steps to squares the enemy does not attack.
+template<PieceColor Us, GenType Type>
+void MoveGenerator::generate(const Board& board, MoveList& moves) const {
+    constexpr PieceColor Them = (Us == WHITE) ? BLACK : WHITE;
+
+    Bitboard typeMask = (Type == CAPTURES) ? board.occupancy(Them)
+                      : (Type == QUIETS) ? ~board.occupancy() : FULL_BB;
+
+    // A position without a king (test setups) has nothing to pin or check.
+    int king = board.getKingPosition(Us);
+    Bitboard checkers = EMPTY_BB;
+    Bitboard pinned = EMPTY_BB;
+    if (king != Board::NO_SQUARE) {
+        checkers = board.checkers();
+        generateKingMoves(board, king, ~board.occupancy(Us) & typeMask, moves);
+        if (moreThanOne(checkers)) {
+            return;
         }
+        if (Type != CAPTURES && Type != EVASIONS && !checkers) {
+            generateCastling(board, squareRow(king), squareCol(king), moves);
+        }
+        pinned = board.pinnedPieces(Us);
     }
+
+    Bitboard checkMask = checkers ? (Attacks::between(king, lsb(checkers)) | checkers) : FULL_BB;
+    Bitboard targets = ~board.occupancy(Us) & checkMask;
+
+    // Unpinned pawns move in bulk; a pinned pawn is rare and gets its own
+    // pass restricted to its pin line.
+    Bitboard pawns = board.pieces(Us, PAWN);
+    generatePawnMoves<Us, Type>(board, pawns & ~pinned, checkMask, moves);
+    Bitboard pinnedPawns = pawns & pinned;
+    while (pinnedPawns) {
+        int from = popLsb(pinnedPawns);
+        generatePawnMoves<Us, Type>(board, squareBB(from), checkMask & Attacks::line(king, from), moves);
+    }
+
+    targets &= typeMask;
+    generatePieceMoves<Us, KNIGHT>(board, targets, pinned, king, moves);
+    generatePieceMoves<Us, BISHOP>(board, targets, pinned, king, moves);
+    generatePieceMoves<Us, ROOK>(board, targets, pinned, king, moves);
+    generatePieceMoves<Us, QUEEN>(board, targets, pinned, king, moves);
+
+    if (Type != QUIETS) {
+        generateEnPassant(board, true, moves);
+    }
+}
+
+void MoveGenerator::generateLegalMoves(const Board& board, MoveList& moves, GenType type) const {
+    switch (type) {
+        case CAPTURES:  generate<CAPTURES>(board, moves); break;
+        case QUIETS:    generate<QUIETS>(board, moves); break;
+        case EVASIONS:  generate<EVASIONS>(board, moves); break;
+        case ALL_MOVES: generate<ALL_MOVES>(board, moves); break;
+    }
+}
+
+MoveList MoveGenerator::generateLegalMoves(const Board& board) const {
+    MoveList moves;
+    generate<ALL_MOVES>(board, moves);
     return moves;
 }
 
+// Cheap sanity check for moves that come from outside the generator (hash
+// moves), which may belong to a different position after a key collision.
+bool MoveGenerator::isPseudoLegal(const Board& board, const Move& move) const {
+    // Only promotions may carry promotion bits; anything else would compare
+    // unequal to the generated move it stands for.
+    if (!move.isValid() || (move.type() != PROMOTION && ((move.raw() >> 12) & 3))) {
+        return false;
+    }
 
-std::vector<Move> MoveGenerator::generatePawnMoves(const Board& board, int row, int col) const {
-    std::vector<Move> moves;
-    PieceColor color = board.getPieceAt(row, col).color;
-    int direction = (color == WHITE) ? -1 : 1; 
-    int startRow = (color == WHITE) ? 6 : 1;    
-
-    int advanceRow = row + direction;
-    if (advanceRow >= 0 && advanceRow < 8 && board.getPieceAt(advanceRow, col).isEmpty()) {
-        moves.push_back(Move(row, col, advanceRow, col));
-        if (row == startRow && board.getPieceAt(row + 2 * direction, col).isEmpty()) {
-            moves.push_back(Move(row, col, row + 2 * direction, col));
-        }
+    PieceColor turn = board.getTurn();
+    Piece piece = board.getPieceAt(move.startRow(), move.startCol());
+    int from = move.from();
+    int to = move.to();
+    if (piece.color != turn || (board.occupancy(turn) & squareBB(to))) {
+        return false;
     }
 
-    int captureCols[] = {col - 1, col + 1};
-    for (int captureCol : captureCols) {
-        if (captureCol >= 0 && captureCol < 8) {
-            Piece targetPiece = board.getPieceAt(advanceRow, captureCol);
-            if (!targetPiece.isEmpty() && targetPiece.color != color) {
-                moves.push_back(Move(row, col, advanceRow, captureCol));
+    MoveList pieceMoves;
+    switch (piece.type) {
+        case PAWN:
+            if (turn == WHITE) {
+                generatePawnMoves<WHITE, ALL_MOVES>(board, squareBB(from), FULL_BB, pieceMoves);
+            } else {
+                generatePawnMoves<BLACK, ALL_MOVES>(board, squareBB(from), FULL_BB, pieceMoves);
             }
-        }
+            generateEnPassant(board, false, pieceMoves);
+            break;
+        case KING:
+            if (move.type() != CASTLING) {
+                return move.type() == NORMAL && (Attacks::kingAttacks(from) & squareBB(to));
+            }
+            generateCastling(board, move.startRow(), move.startCol(), pieceMoves);
+            break;
+        default:
+            if (move.type() != NORMAL) return false;
+            return (Attacks::attacksFrom(piece.type, turn, from, board.occupancy()) & squareBB(to)) != 0;
     }
+    return pieceMoves.contains(move);
+}
 
-    return moves;
+// Full legality test for a move already known to be pseudo-legal, without
+// making it on the board.
+bool MoveGenerator::isLegal(const Board& board, const Move& move) const {
+    PieceColor us = board.getTurn();
+    int king = board.getKingPosition(us);
+    if (king == -1 || move.type() == CASTLING) {
+        // Castling was fully checked when the pseudo-legal move was generated.
+        return true;
+    }
+    if (move.type() == EN_PASSANT) {
+        return isEnPassantLegal(board, move.from(), move.to());
+    }
+    if (move.from() == king) {
+        return isKingMoveLegal(board, move.from(), move.to());
+    }
+
+    Bitboard checkers = board.checkers();
+    if (checkers) {
+        if (moreThanOne(checkers)) {
+            return false;
+        }
+        if (!((Attacks::between(king, lsb(checkers)) | checkers) & squareBB(move.to()))) {
+            return false;
+        }
+    }
+    return !(board.pinnedPieces(us) & squareBB(move.from())) ||
+           (Attacks::line(king, move.from()) & squareBB(move.to()));
 }
 
-std::vector<Move> MoveGenerator::generateKnightMoves(const Board& board, int row, int col) const {
-    std::vector<Move> moves;
-    PieceColor color = board.getPieceAt(row, col).color;
-    int knightMoves[8][2] = {{-2, -1}, {-2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}, {2, -1}, {2, 1}};
-
-    for (const auto& move : knightMoves) {
-        int endRow = row + move[0];
-        int endCol = col + move[1];
-        if (endRow >= 0 && endRow < 8 && endCol >= 0 && endCol < 8) {
-            Piece targetPiece = board.getPieceAt(endRow, endCol);
-            if (targetPiece.isEmpty() || targetPiece.color != color) {
-                moves.push_back(Move(row, col, endRow, endCol));
-            }
+// Resolves a UCI string against the legal moves so the special-move flags
+// are filled in; returns the null move when nothing matches.
+Move MoveGenerator::parseMove(const Board& board, const std::string& text) const {
+    for (const Move& move : generateLegalMoves(board)) {
+        if (move.toString() == text) {
+            return move;
         }
     }
-    return moves;
+    return Move();
 }
 
-std::vector<Move> MoveGenerator::generateBishopMoves(const Board& board, int row, int col) const {
-    std::vector<Move> moves;
-    PieceColor color = board.getPieceAt(row, col).color;
-    int directions[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}}; 
-
-    for (const auto& dir : directions) {
-        int dr = dir[0];
-        int dc = dir[1];
-        int endRow = row + dr;
-        int endCol = col + dc;
-        while (endRow >= 0 && endRow < 8 && endCol >= 0 && endCol < 8) {
-            Piece targetPiece = board.getPieceAt(endRow, endCol);
-            if (targetPiece.isEmpty()) {
-                moves.push_back(Move(row, col, endRow, endCol));
-            } else {
-                if (targetPiece.color != color) {
-                    moves.push_back(Move(row, col, endRow, endCol)); 
-                }
-                break; 
-            }
-            endRow += dr;
-            endCol += dc;
+// Pushes and captures for a whole set of pawns at once, each kind being one
+// shift of the pawn bitboard. Only destinations in targets are kept; en
+// passant is generated separately since its legality depends on two vacated
+// squares. Promotions count as captures for the staged generator.
+template<PieceColor Us, GenType Type>
+void MoveGenerator::generatePawnMoves(const Board& board, Bitboard pawns, Bitboard targets,
+                                      MoveList& moves) const {
+    constexpr PieceColor Them = (Us == WHITE) ? BLACK : WHITE;
+    constexpr Direction Up = (Us == WHITE) ? NORTH : SOUTH;
+    constexpr Direction UpWest = (Us == WHITE) ? NORTH_WEST : SOUTH_WEST;
+    constexpr Direction UpEast = (Us == WHITE) ? NORTH_EAST : SOUTH_EAST;
+    constexpr Bitboard promotionRow = rowBB(Us == WHITE ? 0 : 7);
+    constexpr Bitboard doublePushRow = rowBB(Us == WHITE ? 5 : 2);
+
+    Bitboard empty = ~board.occupancy();
+    Bitboard single = shift<Up>(pawns) & empty;
+
+    if (Type != CAPTURES) {
+        Bitboard doubles = shift<Up>(single & doublePushRow) & empty & targets;
+        addShiftedMoves<Up>(single & ~promotionRow & targets, moves);
+        addShiftedMoves<2 * Up>(doubles, moves);
+    }
+
+    if (Type != QUIETS) {
+        Bitboard enemies = board.occupancy(Them) & targets;
+        Bitboard westCaptures = shift<UpWest>(pawns) & enemies;
+        Bitboard eastCaptures = shift<UpEast>(pawns) & enemies;
+
+        addPromotions<Up>(single & promotionRow & targets, moves);
+        addPromotions<UpWest>(westCaptures & promotionRow, moves);
+        addPromotions<UpEast>(eastCaptures & promotionRow, moves);
+        addShiftedMoves<UpWest>(westCaptures & ~promotionRow, moves);
+        addShiftedMoves<UpEast>(eastCaptures & ~promotionRow, moves);
+    }
+}
+
+template<PieceColor Us, PieceType Pt>
+void MoveGenerator::generatePieceMoves(const Board& board, Bitboard targets, Bitboard pinned, int king,
+                                       MoveList& moves) const {
+    Bitboard pieces = board.pieces(Us, Pt);
+    if (Pt == KNIGHT) {
+        // A pinned knight can never stay on its pin line.
+        pieces &= ~pinned;
+    }
+    while (pieces) {
+        int from = popLsb(pieces);
+        Bitboard pieceTargets = targets;
+        if (pinned & squareBB(from)) {
+            pieceTargets &= Attacks::line(king, from);
         }
+        movesToTargets(from, Attacks::attacksFrom(Pt, Us, from, board.occupancy()) & pieceTargets, moves);
     }
-    return moves;
 }
 
-std::vector<Move> MoveGenerator::generateRookMoves(const Board& board, int row, int col) const {
-    std::vector<Move> moves;
-    PieceColor color = board.getPieceAt(row, col).color;
-    int directions[4][2] = {{0, 1}, {0, -1}, {1, 0}, {-1, 0}}; 
-
-    for (const auto& dir : directions) {
-        int dr = dir[0];
-        int dc = dir[1];
-        int endRow = row + dr;
-        int endCol = col + dc;
-        while (endRow >= 0 && endRow < 8 && endCol >= 0 && endCol < 8) {
-            Piece targetPiece = board.getPieceAt(endRow, endCol);
-            if (targetPiece.isEmpty()) {
-                moves.push_back(Move(row, col, endRow, endCol));
-            } else {
-                if (targetPiece.color != color) {
-                    moves.push_back(Move(row, col, endRow, endCol)); 
-                }
-                break; 
-            }
-            endRow += dr;
-            endCol += dc;
+void MoveGenerator::generateEnPassant(const Board& board, bool legalOnly, MoveList& moves) const {
+    int target = board.getEnPassantSquare();
+    if (target == Board::NO_SQUARE) {
+        return;
+    }
+
+    PieceColor us = board.getTurn();
+    PieceColor them = (us == WHITE) ? BLACK : WHITE;
+    Bitboard capturers = Attacks::pawnAttacks(them, target) & board.pieces(us, PAWN);
+    while (capturers) {
+        int from = popLsb(capturers);
+        if (!legalOnly || isEnPassantLegal(board, from, target)) {
+            moves.push_back(Move(from, target, EN_PASSANT));
         }
     }
-    return moves;
 }
 
-std::vector<Move> MoveGenerator::generateQueenMoves(const Board& board, int row, int col) const {
-    std::vector<Move> moves;
-    std::vector<Move> bishopMoves = generateBishopMoves(board, row, col);
-    std::vector<Move> rookMoves = generateRookMoves(board, row, col);
-    moves.insert(moves.end(), bishopMoves.begin(), bishopMoves.end());
-    moves.insert(moves.end(), rookMoves.begin(), rookMoves.end());
-    return moves;
+// Both pawns leave their squares at once, which can uncover a slider on the
+// king's rank; the position is checked with the resulting occupancy.
+bool MoveGenerator::isEnPassantLegal(const Board& board, int from, int to) const {
+    PieceColor us = board.getTurn();
+    PieceColor them = (us == WHITE) ? BLACK : WHITE;
+    int king = board.getKingPosition(us);
+    if (king == -1) {
+        return true;
+    }
+
+    int captured = makeSquare(squareRow(from), squareCol(to));
+    Bitboard occupied = (board.occupancy() ^ squareBB(from) ^ squareBB(captured)) | squareBB(to);
+    return !(board.attackersTo(king, occupied) & board.occupancy(them) & ~squareBB(captured));
 }
 
-std::vector<Move> MoveGenerator::generateKingMoves(const Board& board, int row, int col) const {
-    std::vector<Move> moves;
-    PieceColor color = board.getPieceAt(row, col).color;
-    int kingMoves[8][2] = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}};
-
-    for (const auto& move : kingMoves) {
-        int endRow = row + move[0];
-        int endCol = col + move[1];
-        if (endRow >= 0 && endRow < 8 && endCol >= 0 && endCol < 8) {
-            Piece targetPiece = board.getPieceAt(endRow, endCol);
-            if (targetPiece.isEmpty() || targetPiece.color != color) {
-                moves.push_back(Move(row, col, endRow, endCol));
-            }
+void MoveGenerator::generateKingMoves(const Board& board, int from, Bitboard targets, MoveList& moves) const {
+    targets &= Attacks::kingAttacks(from);
+    while (targets) {
+        int to = popLsb(targets);
+        if (isKingMoveLegal(board, from, to)) {
+            moves.push_back(Move(from, to));
         }
     }
-    return moves;
 }
 
+// The king is lifted off the board so it cannot hide behind itself on a
+// slider's ray.
+bool MoveGenerator::isKingMoveLegal(const Board& board, int from, int to) const {
+    PieceColor them = (board.getTurn() == WHITE) ? BLACK : WHITE;
+    Bitboard occupied = board.occupancy() ^ squareBB(from);
+    return !(board.attackersTo(to, occupied) & board.occupancy(them));
+}
 
-bool MoveGenerator::isMoveLegal(const Board& board, const Move& move) const {
-    Board testBoard = board;
-    Piece movingPiece = testBoard.getPieceAt(move.startRow, move.startCol);
-    testBoard.movePiece(move.startRow, move.startCol, move.endRow, move.endCol);
-    testBoard.setTurn((testBoard.getTurn() == WHITE) ? BLACK : WHITE); 
+void MoveGenerator::generateCastling(const Board& board, int row, int col, MoveList& moves) const {
+    int from = makeSquare(row, col);
+    PieceColor color = board.getPieceAt(row, col).color;
+    int homeRow = (color == WHITE) ? 7 : 0;
+    int rights = board.getCastlingRights() & ((color == WHITE) ? (WHITE_KINGSIDE | WHITE_QUEENSIDE)
+                                                                : (BLACK_KINGSIDE | BLACK_QUEENSIDE));
+    if (!rights || row != homeRow || col != 4) {
+        return;
+    }
+
+    PieceColor opponent = (color == WHITE) ? BLACK : WHITE;
+    if (board.isSquareAttacked(row, col, opponent)) {
+        return;
+    }
+
+    if ((rights & (WHITE_KINGSIDE | BLACK_KINGSIDE)) &&
+        board.getPieceAt(row, 5).isEmpty() && board.getPieceAt(row, 6).isEmpty() &&
+        !board.isSquareAttacked(row, 5, opponent) && !board.isSquareAttacked(row, 6, opponent)) {
+        moves.push_back(Move(from, makeSquare(row, 6), CASTLING));
+    }
+    if ((rights & (WHITE_QUEENSIDE | BLACK_QUEENSIDE)) &&
+        board.getPieceAt(row, 3).isEmpty() && board.getPieceAt(row, 2).isEmpty() &&
+        board.getPieceAt(row, 1).isEmpty() &&
+        !board.isSquareAttacked(row, 3, opponent) && !board.isSquareAttacked(row, 2, opponent)) {
+        moves.push_back(Move(from, makeSquare(row, 2), CASTLING));
+    }
+}
+
+void MoveGenerator::movesToTargets(int from, Bitboard targets, MoveList& moves) const {
+    while (targets) {
+        int to = popLsb(targets);
+        moves.push_back(Move(from, to));
+    }
+}
 
-    return !testBoard.isKingInCheck(movingPiece.color);
-}
\ No newline at end of file
+template void MoveGenerator::generate<WHITE, CAPTURES>(const Board&, MoveList&) const;
+template void MoveGenerator::generate<WHITE, QUIETS>(const Board&, MoveList&) const;
+template void MoveGenerator::generate<WHITE, EVASIONS>(const Board&, MoveList&) const;
+template void MoveGenerator::generate<WHITE, ALL_MOVES>(const Board&, MoveList&) const;
+template void MoveGenerator::generate<BLACK, CAPTURES>(const Board&, MoveList&) const;
+template void MoveGenerator::generate<BLACK, QUIETS>(const Board&, MoveList&) const;
+template void MoveGenerator::generate<BLACK, EVASIONS>(const Board&, MoveList&) const;
+template void MoveGenerator::generate<BLACK, ALL_MOVES>(const Board&, MoveList&) const;
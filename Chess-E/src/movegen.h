@@ -1,22 +1,51 @@
-
 #pragma once
 
 #include "board.h"
 #include "move.h"
-#include <vector>
+#include "move_list.h"
+#include <string>
+
+// CAPTURES holds captures, en passant and every promotion; QUIETS the rest
+// (including castling). Together they are exactly ALL_MOVES. EVASIONS is
+// ALL_MOVES for a side in check: castling is never considered.
+enum GenType {
+    CAPTURES, QUIETS, EVASIONS, ALL_MOVES
+};
 
 class MoveGenerator {
 public:
-    std::vector<Move> generateLegalMoves(const Board& board) const;
-    std::vector<Move> generatePseudoLegalMoves(const Board& board) const;
+    // Legal moves of the requested subset. The color and type are template
+    // parameters so each combination compiles to its own straight-line
+    // generator; the overloads below only pick the instantiation.
+    template<PieceColor Us, GenType Type>
+    void generate(const Board& board, MoveList& moves) const;
+
+    template<GenType Type>
+    void generate(const Board& board, MoveList& moves) const {
+        if (board.getTurn() == WHITE) {
+            generate<WHITE, Type>(board, moves);
+        } else {
+            generate<BLACK, Type>(board, moves);
+        }
+    }
+
+    void generateLegalMoves(const Board& board, MoveList& moves, GenType type = ALL_MOVES) const;
+    MoveList generateLegalMoves(const Board& board) const;
+    bool isPseudoLegal(const Board& board, const Move& move) const;
+    bool isLegal(const Board& board, const Move& move) const;
+    Move parseMove(const Board& board, const std::string& text) const;
 
 private:
-    std::vector<Move> generatePawnMoves(const Board& board, int row, int col) const;
-    std::vector<Move> generateKnightMoves(const Board& board, int row, int col) const;
-    std::vector<Move> generateBishopMoves(const Board& board, int row, int col) const;
-    std::vector<Move> generateRookMoves(const Board& board, int row, int col) const;
-    std::vector<Move> generateQueenMoves(const Board& board, int row, int col) const;
-    std::vector<Move> generateKingMoves(const Board& board, int row, int col) const;
-
-    bool isMoveLegal(const Board& board, const Move& move) const;
-};
\ No newline at end of file
+    template<PieceColor Us, GenType Type>
+    void generatePawnMoves(const Board& board, Bitboard pawns, Bitboard targets, MoveList& moves) const;
+    template<PieceColor Us, PieceType Pt>
+    void generatePieceMoves(const Board& board, Bitboard targets, Bitboard pinned, int king, MoveList& moves) const;
+
+    void generateEnPassant(const Board& board, bool legalOnly, MoveList& moves) const;
+    void generateKingMoves(const Board& board, int from, Bitboard targets, MoveList& moves) const;
+    void generateCastling(const Board& board, int row, int col, MoveList& moves) const;
+    void movesToTargets(int from, Bitboard targets, MoveList& moves) const;
+    bool isKingMoveLegal(const Board& board, int from, int to) const;
+
+    bool isEnPassantLegal(const Board& board, int from, int to) const;
+};
@@ -0,0 +1,347 @@
+#include "nnue.h"
+#include "nnue_kernels.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+namespace NNUE {
+
+const char* const BUILTIN_NETWORK = "builtin";
+
+namespace {
+
+// Every array is 64-byte aligned so each row can be loaded whole by the
+// widest kernel.
+struct Network {
+    alignas(64) std::int16_t ftBias[HALF_DIMENSIONS];
+    alignas(64) std::int16_t ftWeights[INPUT_DIMENSIONS * HALF_DIMENSIONS];
+    alignas(64) std::int32_t l1Bias[L1_OUTPUTS];
+    alignas(64) std::int8_t l1Weights[L1_OUTPUTS * L1_INPUTS];
+    alignas(64) std::int8_t l2Weights[L1_OUTPUTS];
+    std::int32_t l2Bias;
+};
+
+// File layout: the magic, then the format version and the four dimensions as
+// 32-bit integers, then the arrays in declaration order. Everything is
+// little-endian, as written by the machines this engine runs on.
+const char FILE_MAGIC[4] = {'C', 'E', 'N', 'N'};
+const std::uint32_t FILE_VERSION = 1;
+
+struct State {
+    std::unique_ptr<Network> network;
+    std::string name;
+    std::uint64_t id = 0;
+    std::uint32_t generation = 0;
+    bool enabled = false;
+};
+
+State& state() {
+    static State instance;
+    return instance;
+}
+
+std::uint64_t checksum(const Network& network) {
+    // FNV-1a over the weights; the padding between arrays is never written
+    // to, so it is skipped.
+    std::uint64_t hash = 0xCBF29CE484222325ULL;
+    auto mix = [&hash](const void* data, std::size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+        }
+    };
+    mix(network.ftBias, sizeof(network.ftBias));
+    mix(network.ftWeights, sizeof(network.ftWeights));
+    mix(network.l1Bias, sizeof(network.l1Bias));
+    mix(network.l1Weights, sizeof(network.l1Weights));
+    mix(network.l2Weights, sizeof(network.l2Weights));
+    mix(&network.l2Bias, sizeof(network.l2Bias));
+    return hash;
+}
+
+void install(std::unique_ptr<Network> network, const std::string& name) {
+    State& current = state();
+    current.id = checksum(*network);
+    current.network = std::move(network);
+    current.name = name;
+    current.generation++;
+}
+
+// Features are seen from the perspective's side of the board: for Black the
+// squares are mirrored vertically, so both sides share one set of weights.
+int featureIndex(PieceColor perspective, int king, PieceType type, PieceColor color, int square) {
+    int flip = (perspective == WHITE) ? 0 : 56;
+    int piece = type + (color == perspective ? 0 : 5);
+    return (king ^ flip) * FEATURES_PER_KING + piece * 64 + (square ^ flip);
+}
+
+const std::int16_t* featureWeights(const Network& network, int feature) {
+    return network.ftWeights + static_cast<std::size_t>(feature) * HALF_DIMENSIONS;
+}
+
+// The slots below the current ply hold the positions the search came
+// through, so a child is usually one row update away from its parent.
+std::vector<Accumulator>& accumulatorStack(int plies) {
+    thread_local std::vector<Accumulator> stack;
+    if (static_cast<int>(stack.size()) <= plies) {
+        stack.resize(plies + 1);
+    }
+    return stack;
+}
+
+// Points a slot at another position, dropping whatever it held.
+void claim(Accumulator& accumulator, std::uint64_t key) {
+    if (accumulator.key != key) {
+        accumulator.key = key;
+        accumulator.generation[WHITE] = accumulator.generation[BLACK] = 0;
+    }
+}
+
+void refresh(const Board& board, Accumulator& accumulator, PieceColor perspective) {
+    const State& current = state();
+    const Network& network = *current.network;
+    const Kernels& k = kernels();
+    std::int16_t* values = accumulator.values[perspective];
+    int king = board.getKingPosition(perspective);
+
+    claim(accumulator, board.hash());
+    std::memcpy(values, network.ftBias, sizeof(network.ftBias));
+    for (int color = WHITE; color <= BLACK; ++color) {
+        for (int type = PAWN; type <= QUEEN; ++type) {
+            Bitboard pieces = board.pieces(static_cast<PieceColor>(color), static_cast<PieceType>(type));
+            while (pieces) {
+                int feature = featureIndex(perspective, king, static_cast<PieceType>(type),
+                                           static_cast<PieceColor>(color), popLsb(pieces));
+                k.addRow(values, featureWeights(network, feature));
+            }
+        }
+    }
+    accumulator.generation[perspective] = current.generation;
+}
+
+bool movesKing(const DirtyPiece* changes, int count, PieceColor perspective) {
+    for (int i = 0; i < count; ++i) {
+        if (changes[i].piece == (KING | (perspective << 3))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Walks back to the nearest ply whose slot already holds that position for
+// this network and replays the moves of the history forward from it. A move
+// of the perspective's own king changes every feature, and plies before the
+// last edit cannot be replayed at all, so reaching either means a full
+// refresh instead.
+const Accumulator& update(const Board& board, PieceColor perspective) {
+    const State& current = state();
+    int last = board.historySize();
+    std::vector<Accumulator>& stack = accumulatorStack(last);
+    DirtyPiece changes[4];
+
+    int index = last;
+    while (stack[index].key != board.positionHash(index) ||
+           stack[index].generation[perspective] != current.generation) {
+        if (index == board.lastEditIndex() ||
+            movesKing(changes, board.changedPieces(index - 1, changes), perspective)) {
+            refresh(board, stack[last], perspective);
+            return stack[last];
+        }
+        --index;
+    }
+
+    // No own king move lies on the replayed path, so its square is the
+    // current one throughout.
+    const Network& network = *current.network;
+    const Kernels& k = kernels();
+    int king = board.getKingPosition(perspective);
+    for (++index; index <= last; ++index) {
+        Accumulator& child = stack[index];
+        claim(child, board.positionHash(index));
+        std::memcpy(child.values[perspective], stack[index - 1].values[perspective], sizeof(child.values[perspective]));
+        int count = board.changedPieces(index - 1, changes);
+        for (int i = 0; i < count; ++i) {
+            const DirtyPiece& change = changes[i];
+            PieceType type = static_cast<PieceType>(change.piece & 7);
+            if (type == KING) {
+                continue;
+            }
+            int feature = featureIndex(perspective, king, type, static_cast<PieceColor>(change.piece >> 3), change.square);
+            if (change.added) {
+                k.addRow(child.values[perspective], featureWeights(network, feature));
+            } else {
+                k.subRow(child.values[perspective], featureWeights(network, feature));
+            }
+        }
+        child.generation[perspective] = current.generation;
+    }
+    return stack[last];
+}
+
+// A fixed-seed network that plays sensibly without any training: ten
+// feature-transformer outputs count each side's pawns to queens, and the
+// first two layer-one outputs turn the counts into a material balance and
+// its negation. Everything else is small deterministic noise, so the SIMD
+// paths still see nonzero data in every lane.
+std::unique_ptr<Network> buildTestNetwork() {
+    static const int MATERIAL_WEIGHT[5] = {14, 45, 47, 70, 127};
+    static const int COUNT_WEIGHT = 15;
+
+    std::uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    auto noise = [&seed](int range) {
+        // splitmix64
+        std::uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        return static_cast<int>(z % static_cast<std::uint64_t>(2 * range + 1)) - range;
+    };
+
+    std::unique_ptr<Network> network(new Network());
+    for (int i = 0; i < HALF_DIMENSIONS; ++i) {
+        network->ftBias[i] = static_cast<std::int16_t>(i < 10 ? 0 : 8 + noise(8));
+    }
+    for (int feature = 0; feature < INPUT_DIMENSIONS; ++feature) {
+        int piece = (feature % FEATURES_PER_KING) / 64;
+        std::int16_t* row = network->ftWeights + static_cast<std::size_t>(feature) * HALF_DIMENSIONS;
+        for (int i = 0; i < HALF_DIMENSIONS; ++i) {
+            row[i] = static_cast<std::int16_t>(i < 10 ? (i == piece ? COUNT_WEIGHT : 0) : noise(2));
+        }
+    }
+
+    for (int output = 0; output < L1_OUTPUTS; ++output) {
+        std::int8_t* row = network->l1Weights + output * L1_INPUTS;
+        network->l1Bias[output] = 0;
+        for (int i = 0; i < L1_INPUTS; ++i) {
+            int weight;
+            if (output < 2) {
+                int sign = (output == 0) ? 1 : -1;
+                weight = i < 5 ? sign * MATERIAL_WEIGHT[i] : (i < 10 ? -sign * MATERIAL_WEIGHT[i - 5] : 0);
+            } else {
+                weight = noise(2);
+            }
+            row[i] = static_cast<std::int8_t>(weight);
+        }
+        network->l2Weights[output] = static_cast<std::int8_t>(output == 0 ? 33 : (output == 1 ? -33 : noise(1)));
+    }
+    network->l2Bias = 0;
+    return network;
+}
+
+template<typename T>
+bool readArray(std::istream& in, T* data, std::size_t count) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(count * sizeof(T))));
+}
+
+template<typename T>
+void writeArray(std::ostream& out, const T* data, std::size_t count) {
+    out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+}
+
+bool isEnabled() {
+    return state().enabled;
+}
+
+void setEnabled(bool enabled) {
+    if (enabled && !state().network) {
+        useBuiltinNetwork();
+    }
+    state().enabled = enabled;
+}
+
+bool loadNetwork(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    char magic[4];
+    std::uint32_t header[5];
+    if (!readArray(in, magic, 4) || !readArray(in, header, 5) || std::memcmp(magic, FILE_MAGIC, 4) != 0) {
+        return false;
+    }
+    const std::uint32_t expected[5] = {FILE_VERSION, INPUT_DIMENSIONS, HALF_DIMENSIONS, L1_INPUTS, L1_OUTPUTS};
+    if (std::memcmp(header, expected, sizeof(header)) != 0) {
+        return false;
+    }
+
+    std::unique_ptr<Network> network(new Network());
+    if (!readArray(in, network->ftBias, HALF_DIMENSIONS) ||
+        !readArray(in, network->ftWeights, static_cast<std::size_t>(INPUT_DIMENSIONS) * HALF_DIMENSIONS) ||
+        !readArray(in, network->l1Bias, L1_OUTPUTS) ||
+        !readArray(in, network->l1Weights, L1_OUTPUTS * L1_INPUTS) ||
+        !readArray(in, network->l2Weights, L1_OUTPUTS) ||
+        !readArray(in, &network->l2Bias, 1)) {
+        return false;
+    }
+
+    install(std::move(network), path);
+    return true;
+}
+
+bool saveNetwork(const std::string& path) {
+    const Network* network = state().network.get();
+    if (!network) {
+        return false;
+    }
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        return false;
+    }
+
+    const std::uint32_t header[5] = {FILE_VERSION, INPUT_DIMENSIONS, HALF_DIMENSIONS, L1_INPUTS, L1_OUTPUTS};
+    writeArray(out, FILE_MAGIC, 4);
+    writeArray(out, header, 5);
+    writeArray(out, network->ftBias, HALF_DIMENSIONS);
+    writeArray(out, network->ftWeights, static_cast<std::size_t>(INPUT_DIMENSIONS) * HALF_DIMENSIONS);
+    writeArray(out, network->l1Bias, L1_OUTPUTS);
+    writeArray(out, network->l1Weights, L1_OUTPUTS * L1_INPUTS);
+    writeArray(out, network->l2Weights, L1_OUTPUTS);
+    writeArray(out, &network->l2Bias, 1);
+    return static_cast<bool>(out);
+}
+
+void useBuiltinNetwork() {
+    install(buildTestNetwork(), BUILTIN_NETWORK);
+}
+
+const std::string& networkName() {
+    return state().name;
+}
+
+std::uint64_t networkId() {
+    return state().id;
+}
+
+const Accumulator& accumulator(const Board& board) {
+    update(board, WHITE);
+    return update(board, BLACK);
+}
+
+int evaluate(const Board& board) {
+    const Network& network = *state().network;
+    const Kernels& k = kernels();
+    PieceColor us = board.getTurn();
+    PieceColor them = (us == WHITE) ? BLACK : WHITE;
+
+    const Accumulator& accumulator = NNUE::accumulator(board);
+
+    // The side to move's half always comes first, so the layers after the
+    // transformer only ever see "us" and "them".
+    alignas(64) std::uint8_t transformed[L1_INPUTS];
+    k.clippedRelu(accumulator.values[us], transformed);
+    k.clippedRelu(accumulator.values[them], transformed + HALF_DIMENSIONS);
+
+    std::int32_t output = network.l2Bias;
+    for (int i = 0; i < L1_OUTPUTS; ++i) {
+        std::int32_t sum = network.l1Bias[i] + k.dot(transformed, network.l1Weights + i * L1_INPUTS, L1_INPUTS);
+        output += std::clamp(sum >> L1_SHIFT, 0, 127) * network.l2Weights[i];
+    }
+    return output;
+}
+
+}
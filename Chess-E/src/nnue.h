@@ -0,0 +1,50 @@
+#pragma once
+
+#include "board.h"
+#include "nnue_accumulator.h"
+#include <cstdint>
+#include <string>
+
+// An efficiently updatable neural network evaluation, used instead of the
+// hand-written terms when enabled. The first layer takes HalfKP features
+// (king square x non-king piece x square, from each side's point of view)
+// and is kept per ply on each thread, so a move costs a few row additions
+// instead of a full pass over the pieces. The later layers are small int8
+// affine transforms on the clipped accumulator.
+namespace NNUE {
+
+const int FEATURES_PER_KING = 10 * 64;
+const int INPUT_DIMENSIONS = 64 * FEATURES_PER_KING;
+const int L1_INPUTS = 2 * HALF_DIMENSIONS;
+const int L1_OUTPUTS = 32;
+// Layer-one sums are shifted down by this before clipping to [0, 127].
+const int L1_SHIFT = 6;
+
+// The value EvalFile takes to select the deterministic test network that is
+// built in memory, so the evaluator works without any file on disk.
+extern const char* const BUILTIN_NETWORK;
+
+bool isEnabled();
+// Enabling without a network loaded builds the test network.
+void setEnabled(bool enabled);
+
+// Both return false, leaving the current network in place, if the file
+// cannot be read or written or does not describe a network of this shape.
+bool loadNetwork(const std::string& path);
+bool saveNetwork(const std::string& path);
+void useBuiltinNetwork();
+
+const std::string& networkName();
+// A checksum of the weights. Evaluations made with different networks must
+// not share EvalCache entries, so the cache key is salted with it.
+std::uint64_t networkId();
+
+// The position's first-layer sums, brought up to date. The reference stays
+// valid until the next evaluation on the same thread.
+const Accumulator& accumulator(const Board& board);
+
+// Score from the side to move's point of view in centipawns. Both kings
+// must be on the board.
+int evaluate(const Board& board);
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+
+namespace NNUE {
+
+// Outputs of the feature transformer for one perspective.
+const int HALF_DIMENSIONS = 64;
+
+// A piece that left or entered a square, as a Board mailbox code
+// (type | color << 3).
+struct DirtyPiece {
+    std::uint8_t piece;
+    std::int8_t square;
+    bool added;
+};
+
+// First-layer sums for both perspectives of one position. Each search
+// thread keeps a stack of these indexed by the ply of the Board's history,
+// and the key says which position a slot currently holds.
+struct Accumulator {
+    alignas(64) std::int16_t values[2][HALF_DIMENSIONS];
+    // Generation of the network each perspective was computed with; zero
+    // when it has not been. Loading another network makes every stored
+    // accumulator stale at once.
+    std::uint32_t generation[2];
+    std::uint64_t key;
+
+    // values are left uninitialized on purpose: most slots are overwritten
+    // before they are ever read.
+    Accumulator() : generation{0, 0}, key(0) {}
+};
+
+}
@@ -0,0 +1,252 @@
+#include "nnue_kernels.h"
+#include "cpu_features.h"
+#include <algorithm>
+
+#if CHESS_X86
+#include <immintrin.h>
+#endif
+
+namespace NNUE {
+
+namespace {
+
+const int H = HALF_DIMENSIONS;
+
+void addRowScalar(std::int16_t* accumulator, const std::int16_t* weights) {
+    for (int i = 0; i < H; ++i) {
+        accumulator[i] = static_cast<std::int16_t>(accumulator[i] + weights[i]);
+    }
+}
+
+void subRowScalar(std::int16_t* accumulator, const std::int16_t* weights) {
+    for (int i = 0; i < H; ++i) {
+        accumulator[i] = static_cast<std::int16_t>(accumulator[i] - weights[i]);
+    }
+}
+
+void clippedReluScalar(const std::int16_t* input, std::uint8_t* output) {
+    for (int i = 0; i < H; ++i) {
+        output[i] = static_cast<std::uint8_t>(std::max<int>(0, std::min<int>(127, input[i])));
+    }
+}
+
+std::int32_t dotScalar(const std::uint8_t* input, const std::int8_t* weights, int size) {
+    std::int32_t sum = 0;
+    for (int i = 0; i < size; ++i) {
+        sum += input[i] * weights[i];
+    }
+    return sum;
+}
+
+#if CHESS_X86
+// SSE4.1 ------------------------------------------------------------------
+
+TARGET_ATTRIBUTE("sse4.1")
+void addRowSse41(std::int16_t* accumulator, const std::int16_t* weights) {
+    __m128i* acc = reinterpret_cast<__m128i*>(accumulator);
+    const __m128i* w = reinterpret_cast<const __m128i*>(weights);
+    for (int i = 0; i < H / 8; ++i) {
+        acc[i] = _mm_add_epi16(acc[i], _mm_loadu_si128(w + i));
+    }
+}
+
+TARGET_ATTRIBUTE("sse4.1")
+void subRowSse41(std::int16_t* accumulator, const std::int16_t* weights) {
+    __m128i* acc = reinterpret_cast<__m128i*>(accumulator);
+    const __m128i* w = reinterpret_cast<const __m128i*>(weights);
+    for (int i = 0; i < H / 8; ++i) {
+        acc[i] = _mm_sub_epi16(acc[i], _mm_loadu_si128(w + i));
+    }
+}
+
+// packs saturates to [-128, 127]; the signed max with zero finishes the clamp.
+TARGET_ATTRIBUTE("sse4.1")
+void clippedReluSse41(const std::int16_t* input, std::uint8_t* output) {
+    const __m128i* in = reinterpret_cast<const __m128i*>(input);
+    __m128i* out = reinterpret_cast<__m128i*>(output);
+    for (int i = 0; i < H / 16; ++i) {
+        __m128i packed = _mm_packs_epi16(in[2 * i], in[2 * i + 1]);
+        out[i] = _mm_max_epi8(packed, _mm_setzero_si128());
+    }
+}
+
+// maddubs multiplies unsigned by signed bytes and adds neighbouring pairs to
+// int16; inputs are at most 127, so a pair cannot saturate.
+TARGET_ATTRIBUTE("sse4.1")
+std::int32_t dotSse41(const std::uint8_t* input, const std::int8_t* weights, int size) {
+    const __m128i ones = _mm_set1_epi16(1);
+    __m128i sum = _mm_setzero_si128();
+    for (int i = 0; i < size; i += 16) {
+        __m128i products = _mm_maddubs_epi16(_mm_load_si128(reinterpret_cast<const __m128i*>(input + i)),
+                                             _mm_load_si128(reinterpret_cast<const __m128i*>(weights + i)));
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(products, ones));
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+    return _mm_cvtsi128_si32(sum);
+}
+
+// AVX2 --------------------------------------------------------------------
+
+TARGET_ATTRIBUTE("avx2")
+void addRowAvx2(std::int16_t* accumulator, const std::int16_t* weights) {
+    __m256i* acc = reinterpret_cast<__m256i*>(accumulator);
+    const __m256i* w = reinterpret_cast<const __m256i*>(weights);
+    for (int i = 0; i < H / 16; ++i) {
+        acc[i] = _mm256_add_epi16(acc[i], _mm256_loadu_si256(w + i));
+    }
+}
+
+TARGET_ATTRIBUTE("avx2")
+void subRowAvx2(std::int16_t* accumulator, const std::int16_t* weights) {
+    __m256i* acc = reinterpret_cast<__m256i*>(accumulator);
+    const __m256i* w = reinterpret_cast<const __m256i*>(weights);
+    for (int i = 0; i < H / 16; ++i) {
+        acc[i] = _mm256_sub_epi16(acc[i], _mm256_loadu_si256(w + i));
+    }
+}
+
+// The 256-bit pack works per 128-bit lane; the permute restores order.
+TARGET_ATTRIBUTE("avx2")
+void clippedReluAvx2(const std::int16_t* input, std::uint8_t* output) {
+    const __m256i* in = reinterpret_cast<const __m256i*>(input);
+    __m256i* out = reinterpret_cast<__m256i*>(output);
+    for (int i = 0; i < H / 32; ++i) {
+        __m256i packed = _mm256_packs_epi16(in[2 * i], in[2 * i + 1]);
+        packed = _mm256_permute4x64_epi64(packed, 0xD8);
+        out[i] = _mm256_max_epi8(packed, _mm256_setzero_si256());
+    }
+}
+
+TARGET_ATTRIBUTE("avx2")
+std::int32_t horizontalSumAvx2(__m256i sum) {
+    __m128i folded = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    folded = _mm_add_epi32(folded, _mm_shuffle_epi32(folded, 0x4E));
+    folded = _mm_add_epi32(folded, _mm_shuffle_epi32(folded, 0xB1));
+    return _mm_cvtsi128_si32(folded);
+}
+
+TARGET_ATTRIBUTE("avx2")
+std::int32_t dotAvx2(const std::uint8_t* input, const std::int8_t* weights, int size) {
+    const __m256i ones = _mm256_set1_epi16(1);
+    __m256i sum = _mm256_setzero_si256();
+    for (int i = 0; i < size; i += 32) {
+        __m256i products = _mm256_maddubs_epi16(_mm256_load_si256(reinterpret_cast<const __m256i*>(input + i)),
+                                                _mm256_load_si256(reinterpret_cast<const __m256i*>(weights + i)));
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(products, ones));
+    }
+    return horizontalSumAvx2(sum);
+}
+
+// AVX-512 -----------------------------------------------------------------
+
+TARGET_ATTRIBUTE("avx512f,avx512bw")
+void addRowAvx512(std::int16_t* accumulator, const std::int16_t* weights) {
+    for (int i = 0; i < H; i += 32) {
+        __m512i acc = _mm512_load_si512(accumulator + i);
+        _mm512_store_si512(accumulator + i, _mm512_add_epi16(acc, _mm512_loadu_si512(weights + i)));
+    }
+}
+
+TARGET_ATTRIBUTE("avx512f,avx512bw")
+void subRowAvx512(std::int16_t* accumulator, const std::int16_t* weights) {
+    for (int i = 0; i < H; i += 32) {
+        __m512i acc = _mm512_load_si512(accumulator + i);
+        _mm512_store_si512(accumulator + i, _mm512_sub_epi16(acc, _mm512_loadu_si512(weights + i)));
+    }
+}
+
+// Only 64 bytes of output per perspective: the AVX2 transform is already a
+// single pass, so AVX-512 reuses it.
+TARGET_ATTRIBUTE("avx512f,avx512bw")
+std::int32_t dotAvx512(const std::uint8_t* input, const std::int8_t* weights, int size) {
+    if (size % 64 != 0) {
+        return dotAvx2(input, weights, size);
+    }
+    const __m512i ones = _mm512_set1_epi16(1);
+    __m512i sum = _mm512_setzero_si512();
+    for (int i = 0; i < size; i += 64) {
+        __m512i products = _mm512_maddubs_epi16(_mm512_load_si512(input + i), _mm512_load_si512(weights + i));
+        sum = _mm512_add_epi32(sum, _mm512_madd_epi16(products, ones));
+    }
+    return _mm512_reduce_add_epi32(sum);
+}
+#endif
+
+const Kernels KERNELS[SIMD_LEVEL_COUNT] = {
+    {addRowScalar, subRowScalar, clippedReluScalar, dotScalar},
+#if CHESS_X86
+    {addRowSse41, subRowSse41, clippedReluSse41, dotSse41},
+    {addRowAvx2, subRowAvx2, clippedReluAvx2, dotAvx2},
+    {addRowAvx512, subRowAvx512, clippedReluAvx2, dotAvx512},
+#else
+    // Never selected on other architectures; kept so the table is complete.
+    {addRowScalar, subRowScalar, clippedReluScalar, dotScalar},
+    {addRowScalar, subRowScalar, clippedReluScalar, dotScalar},
+    {addRowScalar, subRowScalar, clippedReluScalar, dotScalar},
+#endif
+};
+
+SimdLevel bestSupportedLevel() {
+    for (int level = SIMD_LEVEL_COUNT - 1; level > SCALAR; --level) {
+        if (simdSupported(static_cast<SimdLevel>(level))) {
+            return static_cast<SimdLevel>(level);
+        }
+    }
+    return SCALAR;
+}
+
+SimdLevel& activeLevel() {
+    static SimdLevel level = bestSupportedLevel();
+    return level;
+}
+
+}
+
+const Kernels& kernels() {
+    return KERNELS[activeLevel()];
+}
+
+bool simdSupported(SimdLevel level) {
+    switch (level) {
+        case SCALAR: return true;
+        case SSE41:  return CHESS_X86 && cpuFeatures().sse41;
+        case AVX2:   return CHESS_X86 && cpuFeatures().avx2;
+        case AVX512: return CHESS_X86 && cpuFeatures().avx512bw;
+        default:     return false;
+    }
+}
+
+bool setSimdLevel(SimdLevel level) {
+    if (!simdSupported(level)) {
+        return false;
+    }
+    activeLevel() = level;
+    return true;
+}
+
+SimdLevel simdLevel() {
+    return activeLevel();
+}
+
+const char* simdName(SimdLevel level) {
+    switch (level) {
+        case SCALAR: return "scalar";
+        case SSE41:  return "sse4.1";
+        case AVX2:   return "avx2";
+        case AVX512: return "avx512";
+        default:     return "unknown";
+    }
+}
+
+bool parseSimdLevel(const std::string& name, SimdLevel& level) {
+    for (int i = 0; i < SIMD_LEVEL_COUNT; ++i) {
+        if (name == simdName(static_cast<SimdLevel>(i))) {
+            level = static_cast<SimdLevel>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "nnue_accumulator.h"
+#include <cstdint>
+#include <string>
+
+namespace NNUE {
+
+// Kernel sets for the integer network arithmetic. Every level produces
+// bit-identical results; SCALAR is the reference the others are tested
+// against.
+enum SimdLevel {
+    SCALAR, SSE41, AVX2, AVX512, SIMD_LEVEL_COUNT
+};
+
+struct Kernels {
+    // accumulator[i] += / -= weights[i] for one HALF_DIMENSIONS row.
+    void (*addRow)(std::int16_t* accumulator, const std::int16_t* weights);
+    void (*subRow)(std::int16_t* accumulator, const std::int16_t* weights);
+    // Clamps one HALF_DIMENSIONS accumulator to [0, 127] as bytes.
+    void (*clippedRelu)(const std::int16_t* input, std::uint8_t* output);
+    // Sum of input[i] * weights[i]; size is a multiple of 32 and both
+    // pointers are 64-byte aligned.
+    std::int32_t (*dot)(const std::uint8_t* input, const std::int8_t* weights, int size);
+};
+
+// The best supported level is selected on first use.
+const Kernels& kernels();
+
+bool simdSupported(SimdLevel level);
+bool setSimdLevel(SimdLevel level);
+SimdLevel simdLevel();
+const char* simdName(SimdLevel level);
+bool parseSimdLevel(const std::string& name, SimdLevel& level);
+
+}
@@ -1,30 +1,30 @@
 #include "opening_book.h"
+#include "movegen.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <regex>
 #include <algorithm>
+#include <numeric>
 
 OpeningBook::OpeningBook() : rng(std::random_device()()) {
     loadBook();
 }
 
 Move OpeningBook::probe(const Board& board) const {
-    std::string fen = normalizeFen(board.toFen());
-    auto it = bookData.find(fen);
+    auto it = bookData.find(board.hash());
     if (it != bookData.end()) {
         return selectWeightedMove(it->second.moves, it->second.weights);
     }
-    return Move(-1, -1, -1, -1);
+    return Move();
 }
 
 bool OpeningBook::isInBook(const Board& board) const {
-    return bookData.find(normalizeFen(board.toFen())) != bookData.end();
+    return bookData.find(board.hash()) != bookData.end();
 }
 
 std::vector<Move> OpeningBook::getAllBookMoves(const Board& board) const {
-    std::string fen = normalizeFen(board.toFen());
-    auto it = bookData.find(fen);
+    auto it = bookData.find(board.hash());
     if (it != bookData.end()) {
         return it->second.moves;
     }
@@ -45,7 +45,7 @@ void OpeningBook::loadBook() {
         
         // Read FEN
         std::getline(iss, fen, '|');
-        fen = normalizeFen(fen);
+        Board position(fen);
         
         // Read moves
         std::getline(iss, movesStr, '|');
@@ -53,7 +53,7 @@ void OpeningBook::loadBook() {
         std::istringstream movesIss(movesStr);
         std::string moveStr;
         while (movesIss >> moveStr) {
-            moves.push_back(parseMove(moveStr));
+            moves.push_back(parseMove(position, moveStr));
         }
         
         std::vector<int> weights;
@@ -73,54 +73,29 @@ void OpeningBook::loadBook() {
             weights.resize(moves.size(), 1);
         }
         
-        bookData[fen] = {moves, weights};
+        int totalWeight = std::accumulate(weights.begin(), weights.end(), 0);
+        bookData[position.hash()] = {moves, weights, totalWeight};
     }
 }
 
-Move OpeningBook::parseMove(const std::string& moveStr) const {
+Move OpeningBook::parseMove(const Board& position, const std::string& moveStr) const {
     if (moveStr.length() == 4) {
-        int startCol = moveStr[0] - 'a';
-        int startRow = 8 - (moveStr[1] - '0');
-        int endCol = moveStr[2] - 'a';
-        int endRow = 8 - (moveStr[3] - '0');
-        return Move(startRow, startCol, endRow, endCol);
+        return MoveGenerator().parseMove(position, moveStr);
     }
     
     std::regex pieceRegex("^([NBRQK])?([a-h])([1-8])([x:])?([a-h])([1-8])$");
     std::smatch matches;
     if (std::regex_match(moveStr, matches, pieceRegex)) {
-        int endCol = matches[5].str()[0] - 'a';
-        int endRow = 8 - (matches[6].str()[0] - '0');
-
-        return Move(-1, -1, endRow, endCol);
+        // Long algebraic with a piece letter, e.g. "Ng1f3" or "Bf1xb5".
+        return MoveGenerator().parseMove(position, matches[2].str() + matches[3].str() +
+                                                   matches[5].str() + matches[6].str());
     }
     
-    return Move(-1, -1, -1, -1);
-}
-
-std::string OpeningBook::normalizeFen(const std::string& fen) const {
-    std::istringstream iss(fen);
-    std::string normalized;
-    std::string part;
-    
-    std::getline(iss, part, ' ');
-    normalized += part;
-    
-    std::getline(iss, part, ' ');
-    normalized += " " + part;
-    
-    std::getline(iss, part, ' ');
-    normalized += " " + part;
-    
-    std::getline(iss, part, ' ');
-    normalized += " " + part;
-    
-    return normalized;
+    return Move();
 }
 
 bool OpeningBook::isBookMove(const Board& board, const Move& move) const {
-    std::string fen = normalizeFen(board.toFen());
-    auto it = bookData.find(fen);
+    auto it = bookData.find(board.hash());
     if (it != bookData.end()) {
         return std::find(it->second.moves.begin(), it->second.moves.end(), move) != it->second.moves.end();
     }
@@ -129,7 +104,7 @@ bool OpeningBook::isBookMove(const Board& board, const Move& move) const {
 
 Move OpeningBook::selectWeightedMove(const std::vector<Move>& moves, const std::vector<int>& weights) const {
     if (moves.empty()) {
-        return Move(-1, -1, -1, -1);
+        return Move();
     }
     
     int totalWeight = 0;
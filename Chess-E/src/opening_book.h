@@ -2,6 +2,7 @@
 
 #include "board.h"
 #include "move.h"
+#include <cstdint>
 #include <unordered_map>
 #include <string>
 #include <vector>
@@ -22,11 +23,10 @@ private:
         int totalWeight;
     };
 
-    std::unordered_map<std::string, BookEntry> bookData; // FEN -> BookEntry mapping
+    std::unordered_map<std::uint64_t, BookEntry> bookData; // Board::hash() -> BookEntry mapping
     mutable std::mt19937 rng; 
 
-    Move parseMove(const std::string& moveStr) const;
-    std::string normalizeFen(const std::string& fen) const;
+    Move parseMove(const Board& position, const std::string& moveStr) const;
     bool isBookMove(const Board& board, const Move& move) const;
     Move selectWeightedMove(const std::vector<Move>& moves, const std::vector<int>& weights) const;
 };
\ No newline at end of file
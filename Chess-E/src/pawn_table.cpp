@@ -0,0 +1,75 @@
+#include "pawn_table.h"
+
+namespace {
+
+const int DOUBLED_PENALTY = 20;
+const int ISOLATED_PENALTY = 15;
+const int PASSED_BONUS = 30;
+
+// Squares ahead of each pawn on its own file, from the pawn's point of view.
+template<PieceColor Us>
+Bitboard frontSpan(Bitboard pawns) {
+    return (Us == WHITE) ? shift<NORTH>(northFill(pawns)) : shift<SOUTH>(southFill(pawns));
+}
+
+template<PieceColor Us>
+Bitboard pawnAttacks(Bitboard pawns) {
+    return (Us == WHITE) ? shift<NORTH_WEST>(pawns) | shift<NORTH_EAST>(pawns)
+                         : shift<SOUTH_WEST>(pawns) | shift<SOUTH_EAST>(pawns);
+}
+
+// A pawn is passed when no enemy pawn stands ahead of it on its own or an
+// adjacent file; only the front pawn of a doubled pair can be passed.
+template<PieceColor Us>
+Bitboard passedPawns(Bitboard ours, Bitboard theirs) {
+    constexpr PieceColor Them = (Us == WHITE) ? BLACK : WHITE;
+    Bitboard theirSpans = frontSpan<Them>(theirs);
+    Bitboard blocked = theirSpans | shift<EAST>(theirSpans) | shift<WEST>(theirSpans);
+    Bitboard behindOwnPawn = ours & frontSpan<Them>(ours);
+    return ours & ~blocked & ~behindOwnPawn;
+}
+
+// Doubled pawns are every pawn beyond the first on a file; isolated pawns
+// are counted once per file with no friendly pawns next to it.
+template<PieceColor Us>
+int structureScore(Bitboard ours, Bitboard passed) {
+    constexpr PieceColor Them = (Us == WHITE) ? BLACK : WHITE;
+    Bitboard files = fileFill(ours);
+    Bitboard isolatedFiles = files & ~shift<EAST>(files) & ~shift<WEST>(files);
+    int doubled = popCount(ours & frontSpan<Them>(ours));
+    int isolated = popCount(isolatedFiles & rowBB(0));
+    return popCount(passed) * PASSED_BONUS - doubled * DOUBLED_PENALTY - isolated * ISOLATED_PENALTY;
+}
+
+}
+
+// A zeroed entry is exactly the entry of a position without pawns (key 0),
+// so the table needs no separate empty marker.
+PawnTable::PawnTable() : entries(new PawnEntry[SIZE]()) {}
+
+const PawnEntry& PawnTable::probe(const Board& board) {
+    std::uint64_t key = board.pawnHash();
+    PawnEntry& entry = entries[key & (SIZE - 1)];
+    if (entry.key != key) {
+        entry.key = key;
+        compute(board, entry);
+    }
+    return entry;
+}
+
+PawnTable& PawnTable::forThread() {
+    thread_local PawnTable table;
+    return table;
+}
+
+void PawnTable::compute(const Board& board, PawnEntry& entry) {
+    Bitboard white = board.pieces(WHITE, PAWN);
+    Bitboard black = board.pieces(BLACK, PAWN);
+
+    entry.passedPawns[WHITE] = passedPawns<WHITE>(white, black);
+    entry.passedPawns[BLACK] = passedPawns<BLACK>(black, white);
+    entry.pawnAttacks[WHITE] = pawnAttacks<WHITE>(white);
+    entry.pawnAttacks[BLACK] = pawnAttacks<BLACK>(black);
+    entry.score = structureScore<WHITE>(white, entry.passedPawns[WHITE]) -
+                  structureScore<BLACK>(black, entry.passedPawns[BLACK]);
+}
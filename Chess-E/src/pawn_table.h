@@ -0,0 +1,33 @@
+#pragma once
+
+#include "board.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Everything the evaluation derives from the pawns alone.
+struct PawnEntry {
+    std::uint64_t key;
+    int score;                  // doubled, isolated and passed pawn terms, White's view
+    Bitboard passedPawns[2];
+    Bitboard pawnAttacks[2];
+};
+
+// Pawn structure changes on few moves along a search path, so entries keyed
+// by Board::pawnHash are reused far more often than they are computed. Each
+// thread owns its table, so entries need no synchronization.
+class PawnTable {
+public:
+    static const std::size_t SIZE = std::size_t(1) << 14;
+
+    PawnTable();
+
+    const PawnEntry& probe(const Board& board);
+
+    static PawnTable& forThread();
+
+private:
+    std::unique_ptr<PawnEntry[]> entries;
+
+    static void compute(const Board& board, PawnEntry& entry);
+};
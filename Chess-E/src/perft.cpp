@@ -0,0 +1,192 @@
+#include "perft.h"
+#include "attacks.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+
+namespace {
+
+struct SuitePosition {
+    const char* fen;
+    int depth;
+    std::uint64_t nodes;
+};
+
+// Positions and counts from the Chess Programming Wiki perft results page.
+const SuitePosition SUITE[] = {
+    {"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 5, 4865609},
+    {"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4, 4085603},
+    {"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 6, 11030083},
+    {"r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 5, 15833292},
+    {"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 4, 2103487},
+    {"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 4, 3894594},
+};
+
+std::uint64_t nodesPerSecond(std::uint64_t nodes, std::chrono::steady_clock::duration elapsed) {
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    return micros > 0 ? nodes * 1000000 / static_cast<std::uint64_t>(micros) : nodes;
+}
+
+}
+
+Perft::Perft(std::size_t hashMegabytes, int threads) : tableMask(0), threadCount(std::max(1, threads)) {
+    if (hashMegabytes == 0) {
+        return;
+    }
+    std::size_t count = 1;
+    while (count * 2 * sizeof(HashEntry) <= hashMegabytes * 1024 * 1024) {
+        count *= 2;
+    }
+    table.reset(new HashEntry[count]);
+    tableMask = count - 1;
+    for (std::size_t i = 0; i < count; ++i) {
+        table[i].keyXorCount.store(0, std::memory_order_relaxed);
+        table[i].count.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::uint64_t Perft::count(const Board& board, int depth) {
+    if (depth <= 0) {
+        return 1;
+    }
+    MoveList moves;
+    moveGenerator.generate<ALL_MOVES>(board, moves);
+    std::vector<std::uint64_t> counts = splitRoot(board, moves, depth);
+
+    std::uint64_t total = 0;
+    for (std::uint64_t nodes : counts) {
+        total += nodes;
+    }
+    return total;
+}
+
+std::uint64_t Perft::divide(const Board& board, int depth, std::ostream& out) {
+    auto start = std::chrono::steady_clock::now();
+
+    MoveList moves;
+    moveGenerator.generate<ALL_MOVES>(board, moves);
+    std::vector<std::uint64_t> counts = splitRoot(board, moves, std::max(1, depth));
+
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        out << moves[i].toString() << ": " << counts[i] << "\n";
+        total += counts[i];
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    out << "\nNodes searched: " << total << "\n";
+    out << "Time: " << std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() << " ms, "
+        << nodesPerSecond(total, elapsed) << " nps" << std::endl;
+    return total;
+}
+
+bool Perft::runSuite(std::ostream& out) {
+    bool allPassed = true;
+    std::uint64_t totalNodes = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (const SuitePosition& position : SUITE) {
+        Board board(position.fen);
+        std::uint64_t nodes = count(board, position.depth);
+        bool passed = nodes == position.nodes;
+        allPassed = allPassed && passed;
+        totalNodes += nodes;
+
+        out << (passed ? "ok   " : "FAIL ") << "depth " << position.depth << " " << std::setw(10) << nodes;
+        if (!passed) {
+            out << " (expected " << position.nodes << ")";
+        }
+        out << "  " << position.fen << "\n";
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    out << "\nSuite " << (allPassed ? "PASSED" : "FAILED") << " (" << Attacks::backendName(Attacks::sliderBackend)
+        << " sliders): " << totalNodes << " nodes, "
+        << nodesPerSecond(totalNodes, elapsed) << " nps" << std::endl;
+    return allPassed;
+}
+
+std::uint64_t Perft::search(Board& board, int depth) {
+    MoveList moves;
+    moveGenerator.generate<ALL_MOVES>(board, moves);
+    // Bulk counting: the legal moves one ply above the leaves are the leaves.
+    if (depth == 1) {
+        return moves.size();
+    }
+
+    std::uint64_t key = 0;
+    std::uint64_t nodes = 0;
+    if (table) {
+        key = hashKey(board, depth);
+        if (probe(key, nodes)) {
+            return nodes;
+        }
+    }
+
+    for (const Move& move : moves) {
+        board.makeMove(move);
+        nodes += search(board, depth - 1);
+        board.unmakeMove();
+    }
+
+    if (table) {
+        store(key, nodes);
+    }
+    return nodes;
+}
+
+// Root moves are handed out to the worker threads one at a time; each
+// worker searches its own copy of the board.
+std::vector<std::uint64_t> Perft::splitRoot(const Board& board, const MoveList& moves, int depth) {
+    std::vector<std::uint64_t> counts(moves.size(), 0);
+    std::atomic<std::size_t> nextMove(0);
+
+    auto worker = [&]() {
+        Board local = board;
+        for (std::size_t i = nextMove++; i < moves.size(); i = nextMove++) {
+            if (depth == 1) {
+                counts[i] = 1;
+                continue;
+            }
+            local.makeMove(moves[i]);
+            counts[i] = search(local, depth - 1);
+            local.unmakeMove();
+        }
+    };
+
+    int workers = std::min<int>(threadCount, static_cast<int>(moves.size()));
+    if (workers <= 1) {
+        worker();
+        return counts;
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < workers; ++t) {
+        threads.emplace_back(worker);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return counts;
+}
+
+std::uint64_t Perft::hashKey(const Board& board, int depth) {
+    return board.hash() ^ (static_cast<std::uint64_t>(depth) * 0x9E3779B97F4A7C15ULL);
+}
+
+bool Perft::probe(std::uint64_t key, std::uint64_t& nodes) const {
+    const HashEntry& entry = table[key & tableMask];
+    std::uint64_t stored = entry.count.load(std::memory_order_relaxed);
+    if (stored != 0 && (entry.keyXorCount.load(std::memory_order_relaxed) ^ stored) == key) {
+        nodes = stored;
+        return true;
+    }
+    return false;
+}
+
+void Perft::store(std::uint64_t key, std::uint64_t nodes) {
+    HashEntry& entry = table[key & tableMask];
+    entry.count.store(nodes, std::memory_order_relaxed);
+    entry.keyXorCount.store(key ^ nodes, std::memory_order_relaxed);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "board.h"
+#include "movegen.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+// Counts the leaf nodes of the legal move tree to a fixed depth. Used to
+// validate the move generator against known counts and to measure its raw
+// throughput.
+class Perft {
+public:
+    explicit Perft(std::size_t hashMegabytes = 0, int threads = 1);
+
+    std::uint64_t count(const Board& board, int depth);
+
+    // Prints the node count below each root move, then the total and speed.
+    std::uint64_t divide(const Board& board, int depth, std::ostream& out);
+
+    // Checks the standard perft positions; returns false on any mismatch.
+    bool runSuite(std::ostream& out);
+
+private:
+    // Same torn-write-safe layout as the transposition table.
+    struct HashEntry {
+        std::atomic<std::uint64_t> keyXorCount;
+        std::atomic<std::uint64_t> count;
+    };
+
+    std::unique_ptr<HashEntry[]> table;
+    std::size_t tableMask;
+    int threadCount;
+    MoveGenerator moveGenerator;
+
+    std::uint64_t search(Board& board, int depth);
+    std::vector<std::uint64_t> splitRoot(const Board& board, const MoveList& moves, int depth);
+
+    static std::uint64_t hashKey(const Board& board, int depth);
+    bool probe(std::uint64_t key, std::uint64_t& nodes) const;
+    void store(std::uint64_t key, std::uint64_t nodes);
+};
@@ -0,0 +1,80 @@
+#include "perft.h"
+#include "attacks.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+void printUsage() {
+    std::cout << "Usage: perft [options]\n"
+              << "  --suite            check the standard positions (default without --depth)\n"
+              << "  --depth N          run divide to depth N\n"
+              << "  --fen \"FEN\"        position for --depth (default: start position)\n"
+              << "  --hash MB          use a perft hash table of MB megabytes\n"
+              << "  --threads N        split root moves over N threads (default: all cores)\n"
+              << "  --backend NAME     slider attacks: magic, pext or kogge-stone (default: magic)\n"
+              << "  --backends         run the suite once per backend this CPU supports\n";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int depth = 0;
+    std::size_t hashMegabytes = 0;
+    int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    bool allBackends = false;
+    std::string fen = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--suite") {
+            depth = 0;
+        } else if (arg == "--depth" && i + 1 < argc) {
+            depth = std::atoi(argv[++i]);
+        } else if (arg == "--fen" && i + 1 < argc) {
+            fen = argv[++i];
+        } else if (arg == "--hash" && i + 1 < argc) {
+            hashMegabytes = static_cast<std::size_t>(std::atoi(argv[++i]));
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+        } else if (arg == "--backend" && i + 1 < argc) {
+            Attacks::SliderBackend backend;
+            if (!Attacks::parseBackend(argv[++i], backend) || !Attacks::setBackend(backend)) {
+                std::cerr << "Slider backend " << argv[i] << " is not available" << std::endl;
+                return 1;
+            }
+        } else if (arg == "--backends") {
+            allBackends = true;
+            depth = 0;
+        } else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    if (allBackends) {
+        bool passed = true;
+        for (int i = 0; i < Attacks::BACKEND_COUNT; ++i) {
+            Attacks::SliderBackend backend = static_cast<Attacks::SliderBackend>(i);
+            if (!Attacks::setBackend(backend)) {
+                std::cout << "Backend " << Attacks::backendName(backend) << ": not supported\n\n";
+                continue;
+            }
+            // A fresh instance per backend so no run reuses another's hash.
+            Perft perft(hashMegabytes, threads);
+            passed = perft.runSuite(std::cout) && passed;
+            std::cout << "\n";
+        }
+        return passed ? 0 : 1;
+    }
+    Perft perft(hashMegabytes, threads);
+    if (depth <= 0) {
+        return perft.runSuite(std::cout) ? 0 : 1;
+    }
+
+    Board board(fen);
+    perft.divide(board, depth, std::cout);
+    return 0;
+}
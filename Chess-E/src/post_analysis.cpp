@@ -37,7 +37,7 @@ void PostAnalysis::analyzeGame(const std::vector<Board>& gameHistory) {
         logFile << "Move " << (i + 1) << ":" << std::endl;
         logFile << "Position: " << currentBoard.toFen() << std::endl;
         Move lastMove = deduceLastMove(currentBoard, gameHistory[i+1]);
-        if (lastMove.startRow != -1) {
+        if (lastMove.isValid()) {
             logFile << "   Move: " << moveToString(lastMove) << std::endl;
         }
         logFile << "------------------------" << std::endl;
@@ -61,11 +61,11 @@ std::string PostAnalysis::getTimestamp() const {
 }
 
 std::string PostAnalysis::moveToString(const Move& move) const {
-    if (move.startRow == -1) return "nomove";
-    char startFile = 'a' + move.startCol;
-    int startRank = 8 - move.startRow;
-    char endFile = 'a' + move.endCol;
-    int endRank = 8 - move.endRow;
+    if (!move.isValid()) return "nomove";
+    char startFile = 'a' + move.startCol();
+    int startRank = 8 - move.startRow();
+    char endFile = 'a' + move.endCol();
+    int endRank = 8 - move.endRow();
     std::stringstream ss;
     ss << startFile << startRank << endFile << endRank;
     return ss.str();
@@ -89,5 +89,5 @@ Move PostAnalysis::deduceLastMove(const Board& boardBeforeMove, const Board& boa
             }
         }
     }
-    return Move(-1, -1, -1, -1);
+    return Move();
 }
\ No newline at end of file
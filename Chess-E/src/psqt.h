@@ -0,0 +1,73 @@
+#pragma once
+
+#include "board.h"
+
+namespace PSQT {
+
+// Indexed by PieceType. The king's value only matters in test positions
+// where one side has no king.
+constexpr int PIECE_VALUE[7] = {100, 320, 330, 500, 900, 20000, 0};
+
+// Game phase contributed by each piece type; 24 is the full opening set of
+// minors, rooks and queens.
+constexpr int PHASE_WEIGHT[7] = {0, 1, 1, 2, 4, 0, 0};
+constexpr int MAX_PHASE = 24;
+
+// Material plus piece-square bonus for every piece on every square, signed
+// from White's point of view so a position's score is a plain sum.
+struct Tables {
+    int mg[2][6][64];
+    int eg[2][6][64];
+};
+
+constexpr int distanceFromCenter(int index) {
+    // Twice the distance of a row or column from the board's center line.
+    return index < 4 ? 7 - 2 * index : 2 * index - 7;
+}
+
+constexpr int bonus(PieceType type, PieceColor color, int row, int col, bool endgame) {
+    switch (type) {
+        case PAWN: {  // advancement and central files
+            int advancement = (color == WHITE) ? (7 - row) * 5 : row * 5;
+            return advancement + (4 - distanceFromCenter(col) / 2) * 2;
+        }
+        case KNIGHT: {  // centralized, never on the rim
+            int edgePenalty = ((col == 0 || col == 7) ? -15 : 0) + ((row == 0 || row == 7) ? -15 : 0);
+            int centralBonus = (col >= 2 && col <= 5 && row >= 2 && row <= 5) ? 20 : 0;
+            return centralBonus + edgePenalty;
+        }
+        case BISHOP:  // the long a8-h1 diagonal and the other two corners
+            return (row == col || row - col == 7 || col - row == 7) ? 15 : 0;
+        case ROOK:  // the seventh rank
+            return ((color == WHITE && row == 1) || (color == BLACK && row == 6)) ? 30 : 0;
+        case KING:  // tucked in a corner, centralized once the queens are off
+            if (endgame) {
+                return 14 - (distanceFromCenter(row) + distanceFromCenter(col));
+            }
+            return (row == (color == WHITE ? 7 : 0) || row == (color == WHITE ? 6 : 1)) && (col <= 2 || col >= 5) ? 20 : 0;
+        default:
+            return 0;
+    }
+}
+
+constexpr Tables generateTables() {
+    Tables tables = {};
+    for (int color = WHITE; color <= BLACK; ++color) {
+        int sign = (color == WHITE) ? 1 : -1;
+        for (int type = PAWN; type <= KING; ++type) {
+            for (int square = 0; square < 64; ++square) {
+                PieceType piece = static_cast<PieceType>(type);
+                PieceColor side = static_cast<PieceColor>(color);
+                int row = squareRow(square);
+                int col = squareCol(square);
+                tables.mg[color][type][square] = sign * (PIECE_VALUE[type] + bonus(piece, side, row, col, false));
+                tables.eg[color][type][square] = sign * (PIECE_VALUE[type] + bonus(piece, side, row, col, true));
+            }
+        }
+    }
+    return tables;
+}
+
+inline constexpr Tables TABLES = generateTables();
+
+}
@@ -1,30 +1,31 @@
 #include "quiescence_search.h"
 #include "evaluation.h"
+#include "move_ordering.h"
+#include "see.h"
 
 QuiescenceSearch::QuiescenceSearch() {}
 
-std::vector<Move> QuiescenceSearch::generateCaptureMoves(const Board& board) const {
-    std::vector<Move> moves;
-    for (int row = 0; row < 8; ++row) {
-        for (int col = 0; col < 8; ++col) {
-            Piece piece = board.getPieceAt(row, col);
-            if (!piece.isEmpty() && piece.color == board.getTurn()) {
-                for (int targetRow = 0; targetRow < 8; ++targetRow) {
-                    for (int targetCol = 0; targetCol < 8; ++targetCol) {
-                        if (board.isMoveLegal(row, col, targetRow, targetCol) && 
-                            board.isCapture(row, col, targetRow, targetCol)) {
-                            moves.emplace_back(row, col, targetRow, targetCol);
-                        }
-                    }
-                }
-            }
+void QuiescenceSearch::generateCaptureMoves(const Board& board, MoveList& captures) const {
+    MoveGenerator().generate<CAPTURES>(board, captures);
+}
+
+void QuiescenceSearch::selectCaptures(const Board& board, int standPat, int alpha, ScoredMoveList& captures) const {
+    MoveList moves;
+    generateCaptureMoves(board, moves);
+    for (const Move& move : moves) {
+        int gain = SEE::evaluate(board, move);
+        if (gain < 0 || standPat + gain + DELTA_MARGIN <= alpha) {
+            continue;
         }
+        captures.push_back(move, MoveOrdering::captureScore(board, move));
     }
-    return moves;
 }
 
-int QuiescenceSearch::quiescence(Board& board, int alpha, int beta) {
-    int standPat = Evaluation().evaluate(board);
+int QuiescenceSearch::quiescence(Board& board, int alpha, int beta, int ply) {
+    if (board.checkers() && ply < Evaluation::MAX_PLY - 1) {
+        return searchEvasions(board, alpha, beta, ply);
+    }
+    int standPat = evaluation.evaluate(board, alpha, beta);
     
     if (standPat >= beta) {
         return beta;
@@ -34,13 +35,13 @@ int QuiescenceSearch::quiescence(Board& board, int alpha, int beta) {
         alpha = standPat;
     }
     
-    std::vector<Move> captures = generateCaptureMoves(board);
-    for (const Move& move : captures) {
-        Board nextBoard = board;
-        nextBoard.movePiece(move.startRow, move.startCol, move.endRow, move.endCol);
-        nextBoard.switchTurn();
-        
-        int score = -quiescence(nextBoard, -beta, -alpha);
+    ScoredMoveList captures;
+    selectCaptures(board, standPat, alpha, captures);
+    for (std::size_t i = 0; i < captures.size(); ++i) {
+        Move move = captures.pickBest(i);
+        board.makeMove(move);
+        int score = -quiescence(board, -beta, -alpha, ply + 1);
+        board.unmakeMove();
         
         if (score >= beta) {
             return beta;
@@ -52,4 +53,34 @@ int QuiescenceSearch::quiescence(Board& board, int alpha, int beta) {
     }
     
     return alpha;
-}
\ No newline at end of file
+}
+
+// A capture that gives check can be answered by a quiet move, so none of the
+// evasions may be skipped, and the static score means nothing with the king
+// attacked.
+int QuiescenceSearch::searchEvasions(Board& board, int alpha, int beta, int ply) {
+    MoveList moves;
+    MoveGenerator().generateLegalMoves(board, moves, EVASIONS);
+    if (moves.empty()) {
+        return -Evaluation::CHECKMATE_VALUE + ply;
+    }
+
+    ScoredMoveList evasions;
+    for (const Move& move : moves) {
+        evasions.push_back(move, MoveOrdering::captureScore(board, move));
+    }
+    for (std::size_t i = 0; i < evasions.size(); ++i) {
+        Move move = evasions.pickBest(i);
+        board.makeMove(move);
+        int score = -quiescence(board, -beta, -alpha, ply + 1);
+        board.unmakeMove();
+
+        if (score >= beta) {
+            return beta;
+        }
+        if (score > alpha) {
+            alpha = score;
+        }
+    }
+    return alpha;
+}
@@ -3,11 +3,26 @@
 #include "board.h"
 #include "movegen.h"
 #include "evaluation.h"
-#include <vector>
 
 class QuiescenceSearch {
 public:
     QuiescenceSearch();
-    std::vector<Move> generateCaptureMoves(const Board& board) const;
-    int quiescence(Board& board, int alpha, int beta);
-};
\ No newline at end of file
+    void generateCaptureMoves(const Board& board, MoveList& captures) const;
+    // The captures worth searching from a node whose stand-pat score is
+    // standPat, scored by MVV-LVA for ScoredMoveList::pickBest: those that
+    // lose material by SEE are dropped, as are those whose gain could not
+    // lift the score to alpha.
+    void selectCaptures(const Board& board, int standPat, int alpha, ScoredMoveList& captures) const;
+    // ply is the distance from the root, for mate scores. In check there is
+    // no standing pat: every evasion is searched, and none means mate.
+    int quiescence(Board& board, int alpha, int beta, int ply = 0);
+
+    // Positional slack allowed on top of the exchange gain before a capture
+    // is considered futile.
+    static const int DELTA_MARGIN = 200;
+
+private:
+    Evaluation evaluation;
+
+    int searchEvasions(Board& board, int alpha, int beta, int ply);
+};
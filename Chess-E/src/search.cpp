@@ -1,25 +1,18 @@
 #include "search.h"
+#include "eval_cache.h"
 #include <limits>
 #include <algorithm>
+#include <iomanip>
+#include <iostream>
 
 Search::Search() :
-    evaluationFunction(),
-    moveGenerator(),
     transpositionTable(),
-    quiescenceSearch(),
-    iterativeDeepening(),
-    alphaBetaSearch(),
-    moveOrdering(),
-    pvSearch(),
-    nullMovePruning(),
-    lateMoveReduction(),
-    aspirationWindows(),
+    iterativeDeepening(transpositionTable),
     openingBook(),
     endgameTablebase(),
     timeManagement(),
-    searchExtensions(),
     postAnalysis(),
-    threadPool(std::thread::hardware_concurrency()) 
+    stopHelpers(false)
 {
     searchDepth = 6;
     searchTimeLimit = std::chrono::seconds(5);
@@ -31,100 +24,91 @@ Move Search::findBestMove(Board& board, int depth, std::chrono::milliseconds tim
     searchTimeLimit = timeLimit;
 
     Move bookMove = openingBook.probe(board);
-    if (bookMove.startRow != -1) {
+    if (bookMove.isValid()) {
         return bookMove;
     }
 
+    transpositionTable.newSearch();
+    EvalCache::forThread().resetStats();
+    Evaluation::lazyStats() = {0, 0};
+
+    // Each helper gets its own copy of the board; the main thread's result
+    // is the only one used, the helpers just leave deeper entries behind.
+    // They are not held to the depth limit and keep going until the main
+    // thread is done.
+    stopHelpers = false;
+    std::vector<Board> helperBoards(helpers.size(), board);
+    std::vector<std::future<void>> helperResults;
+    for (std::size_t i = 0; i < helpers.size(); ++i) {
+        helperResults.push_back(threadPool->enqueue([this, i, &helperBoards] {
+            helpers[i]->startSearch(helperBoards[i], Evaluation::MAX_PLY - 1, searchTimeLimit);
+        }));
+    }
     iterativeDeepening.startSearch(board, searchDepth, searchTimeLimit);
+    stopHelpers = true;
+    for (std::future<void>& result : helperResults) {
+        result.get();
+    }
     Move bestMove = iterativeDeepening.getBestMove();
 
+    const EvalCache::Stats& cacheStats = EvalCache::forThread().stats();
+    std::cout << "info string evalcache probes " << cacheStats.probes << " hitrate " << std::fixed
+              << std::setprecision(1) << cacheStats.hitRate() << "% probe " << cacheStats.probeNanoseconds()
+              << " ns" << std::defaultfloat << std::endl;
+    const Evaluation::LazyStats& lazyStats = Evaluation::lazyStats();
+    std::cout << "info string lazyeval evaluations " << lazyStats.evaluations << " skipped " << std::fixed
+              << std::setprecision(1) << lazyStats.skipRate() << "%" << std::defaultfloat << std::endl;
+
     postAnalysis.logSearchData(board, bestMove, iterativeDeepening.getSearchInfo());
 
     return bestMove;
 }
 
 
-int Search::alphaBeta(Board& board, int depth, int alpha, int beta) {
-    if (depth == 0) {
-        return quiescence(board, alpha, beta);
-    }
-
-    int ttValue = transpositionTable.probe(board, depth, alpha, beta);
-    if (ttValue != Evaluation::VALUE_UNKNOWN) {
-        return ttValue;
-    }
-
-    std::vector<Move> moves = moveGenerator.generateLegalMoves(board);
-    moveOrdering.orderMoves(board, moves);
+const TranspositionTable& Search::getTranspositionTable() const {
+    return transpositionTable;
+}
 
-    int bestValue = std::numeric_limits<int>::min();
-    Move bestMove = Move(-1, -1, -1, -1);
+void Search::setHashSize(std::size_t megabytes) {
+    transpositionTable.resize(megabytes);
+}
 
-    for (const auto& move : moves) {
-        Board nextBoard = board;
-        nextBoard.movePiece(move.startRow, move.startCol, move.endRow, move.endCol);
-        nextBoard.switchTurn();
+void Search::clearHash() {
+    transpositionTable.clear();
+}
 
-        int extendedDepth = depth - 1;
-        if (searchExtensions.shouldExtendSearch(nextBoard, move, depth)) {
-            extendedDepth++;
-        }
+IterativeDeepening::SearchInfo Search::getHelperInfo(int index) const {
+    return helpers[index]->getSearchInfo();
+}
 
-        int currentValue = -alphaBeta(nextBoard, extendedDepth, -beta, -alpha);
-        if (currentValue > bestValue) {
-            bestValue = currentValue;
-            bestMove = move;
-        }
-        alpha = std::max(alpha, bestValue);
-        if (beta <= alpha) {
-            break;
+bool Search::helpersSearching() const {
+    for (const std::unique_ptr<IterativeDeepening>& helper : helpers) {
+        if (helper->isSearching()) {
+            return true;
         }
     }
+    return false;
+}
 
-    if (moves.empty()) {
-        if (board.isKingInCheck(board.getTurn())) {
-            return -Evaluation::CHECKMATE_VALUE - depth;
-        } else {
-            return 0; 
-        }
+void Search::newGame() {
+    clearHash();
+    iterativeDeepening.clearHeuristics();
+    for (const std::unique_ptr<IterativeDeepening>& helper : helpers) {
+        helper->clearHeuristics();
     }
-
-    transpositionTable.store(board, depth, bestValue, TranspositionTable::EXACT_VALUE, bestMove);
-
-    return bestValue;
 }
 
-
-int Search::quiescence(Board& board, int alpha, int beta) {
-    int staticEval = evaluationFunction.evaluate(board);
-
-    if (staticEval >= beta) {
-        return beta;
+void Search::setThreads(int threads) {
+    threads = std::clamp(threads, 1, MAX_THREADS);
+    if (threads == getThreads()) {
+        return;
     }
-    if (staticEval > alpha) {
-        alpha = staticEval;
+    threadPool.reset();
+    helpers.clear();
+    for (int i = 1; i < threads; ++i) {
+        helpers.push_back(std::make_unique<IterativeDeepening>(transpositionTable, i, &stopHelpers));
     }
-
-    std::vector<Move> captureMoves = quiescenceSearch.generateCaptureMoves(board);
-    moveOrdering.orderMoves(board, captureMoves);
-
-    for (const auto& move : captureMoves) {
-        Board nextBoard = board;
-        nextBoard.movePiece(move.startRow, move.startCol, move.endRow, move.endCol);
-        nextBoard.switchTurn();
-
-        int currentValue = -quiescence(nextBoard, -beta, -alpha);
-
-        if (currentValue >= beta) {
-            return beta;
-        }
-        if (currentValue > alpha) {
-            alpha = currentValue;
-        }
+    if (!helpers.empty()) {
+        threadPool = std::make_unique<ThreadPool>(helpers.size());
     }
-    return alpha;
 }
-
-const TranspositionTable& Search::getTranspositionTable() const {
-    return alphaBetaSearch.getTranspositionTable();
-}
\ No newline at end of file
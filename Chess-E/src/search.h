@@ -9,10 +9,7 @@
 #include "iterative_deepening.h"
 #include "alphabeta.h"
 #include "move_ordering.h"
-#include "principal_variation_search.h"
-#include "null_move_pruning.h"
-#include "late_move_reduction.h"
-#include "aspiration_windows.h"
+#include "move_picker.h"
 #include "opening_book.h"
 #include "endgame_tablebase.h"
 #include "time_management.h"
@@ -20,7 +17,10 @@
 #include "post_analysis.h"
 #include "thread_pool.h"
 
+#include <atomic>
 #include <chrono>
+#include <memory>
+#include <vector>
 
 class Search {
 public:
@@ -28,31 +28,36 @@ public:
 
     Move findBestMove(Board& board, int depth, std::chrono::milliseconds timeLimit);
     const TranspositionTable& getTranspositionTable() const;
+    void setHashSize(std::size_t megabytes);
+    void clearHash();
+    // Forgets everything learned from earlier positions: the table and every
+    // thread's move ordering heuristics.
+    void newGame();
+    // Lazy SMP: threads - 1 helpers search the same position alongside the
+    // main thread and share nothing with it but the transposition table.
+    void setThreads(int threads);
+    int getThreads() const { return static_cast<int>(helpers.size()) + 1; }
+    // What helper index (0 to threads - 2) did in the last search.
+    IterativeDeepening::SearchInfo getHelperInfo(int index) const;
+    bool helpersSearching() const;
+
+    static constexpr int MAX_THREADS = 64;
 
 private:
-    Evaluation evaluationFunction;
-    MoveGenerator moveGenerator;
+    // The one table every search shares; the kernel that searches it lives
+    // in iterativeDeepening.
     TranspositionTable transpositionTable;
-    QuiescenceSearch quiescenceSearch;
     IterativeDeepening iterativeDeepening;
-    AlphaBetaSearch alphaBetaSearch;
-    MoveOrdering moveOrdering;
-    PrincipalVariationSearch pvSearch;
-    NullMovePruning nullMovePruning;
-    LateMoveReduction lateMoveReduction;
-    AspirationWindows aspirationWindows;
     OpeningBook openingBook;
     EndgameTablebase endgameTablebase;
     TimeManagement timeManagement;
-    SearchExtensions searchExtensions;
     PostAnalysis postAnalysis;
-    ThreadPool threadPool;
+    std::atomic<bool> stopHelpers;
+    std::vector<std::unique_ptr<IterativeDeepening>> helpers;
+    std::unique_ptr<ThreadPool> threadPool;
 
     int searchDepth;
     std::chrono::milliseconds searchTimeLimit;
-
-    int alphaBeta(Board& board, int depth, int alpha, int beta);
-    int quiescence(Board& board, int alpha, int beta);
 };
 
 #endif
\ No newline at end of file
@@ -1,8 +1,9 @@
 #include "search_extensions.h"
+#include "pawn_table.h"
 
 SearchExtensions::SearchExtensions() {}
 
-bool SearchExtensions::shouldExtendSearch(const Board& board, const Move& move, int depth) const {
+bool SearchExtensions::shouldExtendSearch(Board& board, const Move& move, int depth) const {
     if (depth <= 1) return false;
 
     if (isCheckExtension(board, move)) return true;
@@ -13,38 +14,21 @@ bool SearchExtensions::shouldExtendSearch(const Board& board, const Move& move,
     return false;
 }
 
-bool SearchExtensions::isCheckExtension(const Board& board, const Move& move) const {
-    Board nextBoard = board;
-    nextBoard.movePiece(move.startRow, move.startCol, move.endRow, move.endCol);
-    nextBoard.switchTurn();
-    return nextBoard.isKingInCheck(nextBoard.getTurn());
+bool SearchExtensions::isCheckExtension(Board& board, const Move& move) const {
+    board.makeMove(move);
+    bool givesCheck = board.isKingInCheck(board.getTurn());
+    board.unmakeMove();
+    return givesCheck;
 }
 
 bool SearchExtensions::isCaptureExtension(const Board& board, const Move& move) const {
-    return !board.getPieceAt(move.endRow, move.endCol).isEmpty();
+    return !board.getPieceAt(move.endRow(), move.endCol()).isEmpty();
 }
 
 bool SearchExtensions::isPawnPromotionExtension(const Board& board, const Move& move) const {
-    return board.getPieceAt(move.startRow, move.startCol).type == PAWN && (move.endRow == 0 || move.endRow == 7);
+    return board.getPieceAt(move.startRow(), move.startCol()).type == PAWN && (move.endRow() == 0 || move.endRow() == 7);
 }
 
 bool SearchExtensions::isPassedPawnPushExtension(const Board& board, const Move& move, int depth) const {
-    if (board.getPieceAt(move.startRow, move.startCol).type == PAWN) {
-        if (isPassedPawn(board, move.startRow, move.startCol, board.getPieceAt(move.startRow, move.startCol).color)) {
-            return true; 
-        }
-    }
-    return false;
+    return (PawnTable::forThread().probe(board).passedPawns[board.getTurn()] & squareBB(move.from())) != 0;
 }
-
-
-bool SearchExtensions::isPassedPawn(const Board& board, int row, int col, PieceColor color) const {
-    int direction = (color == WHITE) ? -1 : 1;
-    for (int r = row + direction; (color == WHITE ? r >= 0 : r < 8); r += direction) {
-        for (int c = std::max(0, col - 1); c <= std::min(7, col + 1); ++c) {
-            Piece piece = board.getPieceAt(r, c);
-            if (piece.type == PAWN && piece.color != color) return false; 
-        }
-    }
-    return true; 
-}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "see.h"
+#include "attacks.h"
+#include "psqt.h"
+#include <algorithm>
+
+namespace SEE {
+
+int evaluate(const Board& board, const Move& move) {
+    if (move.type() == CASTLING) {
+        return 0;
+    }
+
+    int from = move.from();
+    int to = move.to();
+    PieceColor side = board.getTurn();
+    PieceType attacker = board.getPieceAt(move.startRow(), move.startCol()).type;
+    Bitboard occupied = board.occupancy() ^ squareBB(from);
+
+    // gain[d] is what the side making capture d nets if the exchange ends
+    // right after it.
+    int gain[32];
+    int depth = 0;
+    if (move.type() == EN_PASSANT) {
+        occupied ^= squareBB(to + (side == WHITE ? SOUTH : NORTH));
+        gain[0] = PSQT::PIECE_VALUE[PAWN];
+    } else {
+        PieceType victim = board.getPieceAt(move.endRow(), move.endCol()).type;
+        gain[0] = (victim == EMPTY) ? 0 : PSQT::PIECE_VALUE[victim];
+    }
+    if (move.type() == PROMOTION) {
+        attacker = move.promotionPiece();
+        gain[0] += PSQT::PIECE_VALUE[attacker] - PSQT::PIECE_VALUE[PAWN];
+    }
+
+    Bitboard bishopsQueens = board.pieces(BISHOP) | board.pieces(QUEEN);
+    Bitboard rooksQueens = board.pieces(ROOK) | board.pieces(QUEEN);
+    Bitboard attackers = board.attackersTo(to, occupied) & occupied;
+
+    while (true) {
+        side = (side == WHITE) ? BLACK : WHITE;
+        Bitboard ours = attackers & board.occupancy(side);
+        if (!ours) {
+            break;
+        }
+
+        // The piece standing on the square is taken by the cheapest attacker.
+        depth++;
+        gain[depth] = PSQT::PIECE_VALUE[attacker] - gain[depth - 1];
+
+        PieceType type = PAWN;
+        while (!(ours & board.pieces(side, type))) {
+            type = static_cast<PieceType>(type + 1);
+        }
+        occupied ^= squareBB(lsb(ours & board.pieces(side, type)));
+
+        if (type == PAWN || type == BISHOP || type == QUEEN) {
+            attackers |= Attacks::bishopAttacks(to, occupied) & bishopsQueens;
+        }
+        if (type == ROOK || type == QUEEN) {
+            attackers |= Attacks::rookAttacks(to, occupied) & rooksQueens;
+        }
+        attackers &= occupied;
+        attacker = type;
+    }
+
+    // Each side stops as soon as continuing would do worse than standing pat.
+    while (depth > 0) {
+        gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+        depth--;
+    }
+    return gain[0];
+}
+
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "board.h"
+#include "move.h"
+
+// Static exchange evaluation: the material the side to move wins or loses
+// if both sides keep recapturing on the move's destination with their least
+// valuable piece, each free to stop when going on would lose. Sliders
+// uncovered behind a capturing piece join in (x-rays). Pins and checks are
+// ignored, as is usual for a routine this cheap.
+namespace SEE {
+
+// In centipawns of PSQT::PIECE_VALUE; positive wins material. Quiet moves
+// score zero or less: the loss if the piece simply drops on that square.
+int evaluate(const Board& board, const Move& move);
+
+}
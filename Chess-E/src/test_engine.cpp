@@ -44,9 +44,9 @@ void testEndgameTablebase() {
     std::cout << "Position evaluation: " << eval << "\n";
     
     Move bestMove = tb.getBestMove(kpBoard);
-    if (bestMove.startRow != -1) {
-        std::cout << "Best move: " << char('a' + bestMove.startCol) << 8 - bestMove.startRow
-                  << char('a' + bestMove.endCol) << 8 - bestMove.endRow << "\n";
+    if (bestMove.isValid()) {
+        std::cout << "Best move: " << char('a' + bestMove.startCol()) << 8 - bestMove.startRow()
+                  << char('a' + bestMove.endCol()) << 8 - bestMove.endRow() << "\n";
     }
     
     std::cout << "\nTest 2: Rook Endgame\n";
@@ -61,9 +61,9 @@ void testEndgameTablebase() {
     std::cout << "Position evaluation: " << eval << "\n";
     
     bestMove = tb.getBestMove(rookBoard);
-    if (bestMove.startRow != -1) {
-        std::cout << "Best move: " << char('a' + bestMove.startCol) << 8 - bestMove.startRow
-                  << char('a' + bestMove.endCol) << 8 - bestMove.endRow << "\n";
+    if (bestMove.isValid()) {
+        std::cout << "Best move: " << char('a' + bestMove.startCol()) << 8 - bestMove.startRow()
+                  << char('a' + bestMove.endCol()) << 8 - bestMove.endRow() << "\n";
     }
 }
 
@@ -79,16 +79,16 @@ void testOpeningBook() {
     if (book.isInBook(startBoard)) {
         std::cout << "Position is in book\n";
         Move bookMove = book.probe(startBoard);
-        if (bookMove.startRow != -1) {
-            std::cout << "Book move: " << char('a' + bookMove.startCol) << 8 - bookMove.startRow
-                      << char('a' + bookMove.endCol) << 8 - bookMove.endRow << "\n";
+        if (bookMove.isValid()) {
+            std::cout << "Book move: " << char('a' + bookMove.startCol()) << 8 - bookMove.startRow()
+                      << char('a' + bookMove.endCol()) << 8 - bookMove.endRow() << "\n";
         }
         
         std::vector<Move> allMoves = book.getAllBookMoves(startBoard);
         std::cout << "All book moves: ";
         for (const auto& move : allMoves) {
-            std::cout << char('a' + move.startCol) << 8 - move.startRow
-                      << char('a' + move.endCol) << 8 - move.endRow << " ";
+            std::cout << char('a' + move.startCol()) << 8 - move.startRow()
+                      << char('a' + move.endCol()) << 8 - move.endRow() << " ";
         }
         std::cout << "\n";
     } else {
@@ -103,9 +103,9 @@ void testOpeningBook() {
     if (book.isInBook(e4Board)) {
         std::cout << "Position is in book\n";
         Move bookMove = book.probe(e4Board);
-        if (bookMove.startRow != -1) {
-            std::cout << "Book move: " << char('a' + bookMove.startCol) << 8 - bookMove.startRow
-                      << char('a' + bookMove.endCol) << 8 - bookMove.endRow << "\n";
+        if (bookMove.isValid()) {
+            std::cout << "Book move: " << char('a' + bookMove.startCol()) << 8 - bookMove.startRow()
+                      << char('a' + bookMove.endCol()) << 8 - bookMove.endRow() << "\n";
         }
     } else {
         std::cout << "Position is not in book\n";
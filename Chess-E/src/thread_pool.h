@@ -7,15 +7,20 @@
 #include <condition_variable>
 #include <functional>
 #include <future>
+#include <memory>
+#include <stdexcept>
 
 class ThreadPool {
 public:
     explicit ThreadPool(size_t numThreads);
     ~ThreadPool();
 
+    // Defined here so any translation unit can instantiate it.
     template<class F, class... Args>
     auto enqueue(F&& f, Args&&... args)
-        -> std::future<typename std::result_of<F(Args...)>::type>;
+        -> std::future<std::invoke_result_t<F, Args...>>;
+
+    size_t size() const { return workers.size(); }
 
 private:
     std::vector<std::thread> workers;
@@ -24,4 +29,26 @@ private:
     std::mutex queueMutex;
     std::condition_variable condition;
     bool stop;
-};
\ No newline at end of file
+};
+
+template<class F, class... Args>
+auto ThreadPool::enqueue(F&& f, Args&&... args)
+    -> std::future<std::invoke_result_t<F, Args...>>
+{
+    using return_type = std::invoke_result_t<F, Args...>;
+
+    auto task = std::make_shared<std::packaged_task<return_type()>>(
+        std::bind(std::forward<F>(f), std::forward<Args>(args)...)
+    );
+
+    std::future<return_type> res = task->get_future();
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        if (stop)
+            throw std::runtime_error("enqueue on stopped ThreadPool");
+
+        tasks.emplace([task](){ (*task)(); });
+    }
+    condition.notify_one();
+    return res;
+}
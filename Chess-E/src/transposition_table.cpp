@@ -1,18 +1,106 @@
 #include "transposition_table.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
 
-TranspositionTable::TranspositionTable() : table() {} 
-
-int TranspositionTable::probe(const Board& board, int depth, int alpha, int beta) {
-    std::string fen = board.toFen();
-    auto it = table.find(fen);
-    if (it != table.end()) {
-        const TTEntry& entry = it->second;
-        if (entry.depth >= depth) {
-            if (entry.type == EXACT_VALUE) {
-                return entry.value;
-            } else if (entry.type == ALPHA_VALUE && entry.value <= alpha) {
+namespace {
+
+// The 16-bit move is stored as-is in the low bits of an entry.
+const std::uint64_t MOVE_MASK = 0xFFFF;
+const int VALUE_LIMIT = 32000;
+const std::size_t PARALLEL_CLEAR_BUCKETS = std::size_t(1) << 20;
+
+}
+
+TranspositionTable::TranspositionTable(std::size_t megabytes) : bucketMask(0), generation(0) {
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(std::size_t megabytes) {
+    megabytes = std::max<std::size_t>(1, std::min<std::size_t>(megabytes, MAX_SIZE_MB));
+
+    // Round down to a power of two so the bucket index is a single mask.
+    std::size_t count = 1;
+    while (count * 2 * sizeof(Bucket) <= megabytes * 1024 * 1024) {
+        count *= 2;
+    }
+
+    buckets.reset(new Bucket[count]);
+    bucketMask = count - 1;
+    clear();
+}
+
+void TranspositionTable::clear() {
+    std::size_t count = bucketMask + 1;
+    auto clearRange = [this](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            for (TTEntry& entry : buckets[i].entries) {
+                entry.keyXorData.store(0, std::memory_order_relaxed);
+                entry.data.store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    std::size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+    if (count < PARALLEL_CLEAR_BUCKETS || threadCount == 1) {
+        clearRange(0, count);
+    } else {
+        std::vector<std::thread> workers;
+        std::size_t chunk = count / threadCount;
+        for (std::size_t t = 0; t < threadCount; ++t) {
+            std::size_t begin = t * chunk;
+            std::size_t end = (t + 1 == threadCount) ? count : begin + chunk;
+            workers.emplace_back(clearRange, begin, end);
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+    generation = 0;
+}
+
+void TranspositionTable::newSearch() {
+    generation = (generation + 1) & 0x3F;
+}
+
+int TranspositionTable::hashfull() const {
+    std::size_t sampled = std::min<std::size_t>(bucketMask + 1, 250);
+    int used = 0;
+    for (std::size_t i = 0; i < sampled; ++i) {
+        for (const TTEntry& entry : buckets[i].entries) {
+            std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+            if (data != 0 && unpackGeneration(data) == generation) {
+                used++;
+            }
+        }
+    }
+    return static_cast<int>(used * 1000 / (sampled * BUCKET_SIZE));
+}
+
+const TranspositionTable::TTEntry* TranspositionTable::findEntry(std::uint64_t key, std::uint64_t& data) const {
+    const Bucket& bucket = buckets[key & bucketMask];
+    for (const TTEntry& entry : bucket.entries) {
+        data = entry.data.load(std::memory_order_relaxed);
+        if ((entry.keyXorData.load(std::memory_order_relaxed) ^ data) == key && data != 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+int TranspositionTable::probe(const Board& board, int depth, int alpha, int beta, int ply, Move& bestMove) {
+    std::uint64_t data;
+    bestMove = Move();
+    if (findEntry(board.hash(), data)) {
+        bestMove = unpackMove(data);
+        int value = valueFromTT(unpackValue(data), ply);
+        int type = unpackType(data);
+        if (unpackDepth(data) >= depth) {
+            if (type == EXACT_VALUE) {
+                return value;
+            } else if (type == ALPHA_VALUE && value <= alpha) {
                 return alpha;
-            } else if (entry.type == BETA_VALUE && entry.value >= beta) {
+            } else if (type == BETA_VALUE && value >= beta) {
                 return beta;
             }
         }
@@ -20,21 +108,93 @@ int TranspositionTable::probe(const Board& board, int depth, int alpha, int beta
     return Evaluation::VALUE_UNKNOWN;
 }
 
-void TranspositionTable::store(const Board& board, int depth, int value, int type, const Move& bestMove) {
-    std::string fen = board.toFen();
-    TTEntry entry;
-    entry.value = value;
-    entry.depth = depth;
-    entry.type = type;
-    entry.bestMove = bestMove;
-    table[fen] = entry;
+void TranspositionTable::store(const Board& board, int depth, int value, int type, const Move& bestMove, int ply) {
+    std::uint64_t key = board.hash();
+    value = valueToTT(value, ply);
+    Bucket& bucket = buckets[key & bucketMask];
+
+    TTEntry* target = nullptr;
+    std::uint64_t oldData = 0;
+    for (TTEntry& entry : bucket.entries) {
+        std::uint64_t data = entry.data.load(std::memory_order_relaxed);
+        if ((entry.keyXorData.load(std::memory_order_relaxed) ^ data) == key && data != 0) {
+            target = &entry;
+            oldData = data;
+            break;
+        }
+    }
+
+    if (!target) {
+        // Pick the shallowest, oldest depth-preferred slot; if even that one
+        // outranks the new entry, fall back to the always-replace slot.
+        int lowestPriority = 0;
+        for (int i = 0; i < BUCKET_SIZE - 1; ++i) {
+            std::uint64_t data = bucket.entries[i].data.load(std::memory_order_relaxed);
+            int age = (generation - unpackGeneration(data)) & 0x3F;
+            int priority = (data == 0) ? -1000 : unpackDepth(data) - 8 * age;
+            if (!target || priority < lowestPriority) {
+                target = &bucket.entries[i];
+                lowestPriority = priority;
+            }
+        }
+        if (depth < lowestPriority) {
+            target = &bucket.entries[BUCKET_SIZE - 1];
+        }
+    } else if (!bestMove.isValid()) {
+        // Keep the old best move when this search did not produce one.
+        Move previous = unpackMove(oldData);
+        std::uint64_t data = pack(previous, value, depth, type, generation);
+        target->data.store(data, std::memory_order_relaxed);
+        target->keyXorData.store(key ^ data, std::memory_order_relaxed);
+        return;
+    }
+
+    std::uint64_t data = pack(bestMove, value, depth, type, generation);
+    target->data.store(data, std::memory_order_relaxed);
+    target->keyXorData.store(key ^ data, std::memory_order_relaxed);
 }
 
 Move TranspositionTable::getBestMove(const Board& board) const {
-    std::string fen = board.toFen();
-    auto it = table.find(fen);
-    if (it != table.end()) {
-        return it->second.bestMove;
+    std::uint64_t data;
+    if (findEntry(board.hash(), data)) {
+        return unpackMove(data);
     }
-    return Move(-1, -1, -1, -1); 
-}
\ No newline at end of file
+    return Move();
+}
+
+int TranspositionTable::boundType(int value, int originalAlpha, int beta) {
+    if (value <= originalAlpha) return ALPHA_VALUE;
+    if (value >= beta) return BETA_VALUE;
+    return EXACT_VALUE;
+}
+
+// Mate scores are stored as distance from this node rather than from the
+// root, so the entry stays valid wherever the position is reached again.
+int TranspositionTable::valueToTT(int value, int ply) {
+    if (value >= Evaluation::MATE_IN_MAX_PLY) return value + ply;
+    if (value <= -Evaluation::MATE_IN_MAX_PLY) return value - ply;
+    return value;
+}
+
+int TranspositionTable::valueFromTT(int value, int ply) {
+    if (value >= Evaluation::MATE_IN_MAX_PLY) return value - ply;
+    if (value <= -Evaluation::MATE_IN_MAX_PLY) return value + ply;
+    return value;
+}
+
+std::uint64_t TranspositionTable::pack(const Move& move, int value, int depth, int type, int generation) {
+    std::uint64_t packedMove = move.raw();
+
+    value = std::max(-VALUE_LIMIT, std::min(VALUE_LIMIT, value));
+    depth = std::max(0, std::min(254, depth + 1));
+
+    return packedMove |
+           (static_cast<std::uint64_t>(static_cast<std::uint16_t>(value)) << 16) |
+           (static_cast<std::uint64_t>(depth) << 32) |
+           (static_cast<std::uint64_t>(type & 0x3) << 40) |
+           (static_cast<std::uint64_t>(generation & 0x3F) << 42);
+}
+
+Move TranspositionTable::unpackMove(std::uint64_t data) {
+    return Move::fromRaw(static_cast<std::uint16_t>(data & MOVE_MASK));
+}
@@ -3,27 +3,75 @@
 #include "board.h"
 #include "move.h"
 #include "evaluation.h"
-#include <unordered_map>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
 
 class TranspositionTable {
 public:
-    TranspositionTable();
+    static const int DEFAULT_SIZE_MB = 16;
+    static const int MAX_SIZE_MB = 4096;
+
+    explicit TranspositionTable(std::size_t megabytes = DEFAULT_SIZE_MB);
 
-    int probe(const Board& board, int depth, int alpha, int beta);
-    void store(const Board& board, int depth, int value, int type, const Move& bestMove);
+    int probe(const Board& board, int depth, int alpha, int beta, int ply, Move& bestMove);
+    void store(const Board& board, int depth, int value, int type, const Move& bestMove, int ply);
     Move getBestMove(const Board& board) const;
 
+    static int boundType(int value, int originalAlpha, int beta);
+
+    void resize(std::size_t megabytes);
+    void clear();
+    void newSearch();
+    int hashfull() const;
+
+    void prefetch(std::uint64_t key) const {
+#if defined(_MSC_VER)
+        _mm_prefetch(reinterpret_cast<const char*>(&buckets[key & bucketMask]), _MM_HINT_T0);
+#else
+        __builtin_prefetch(&buckets[key & bucketMask]);
+#endif
+    }
+
+    // ALPHA_VALUE entries are upper bounds (the node failed low), BETA_VALUE
+    // entries lower bounds (the node failed high).
     static const int EXACT_VALUE = 0;
     static const int ALPHA_VALUE = 1;
     static const int BETA_VALUE = 2;
 
 private:
+    // Both words are written independently and the key is stored XORed with
+    // the data, so a torn write from another thread simply fails to match.
     struct TTEntry {
-        int value;
-        int depth;
-        int type;
-        Move bestMove;
+        std::atomic<std::uint64_t> keyXorData;
+        std::atomic<std::uint64_t> data;
     };
 
-    std::unordered_map<std::string, TTEntry> table; // Key is FEN string for simplicity (hash is better in real engine)
-};
\ No newline at end of file
+    // Slots 0-2 are depth-preferred with aging, slot 3 always takes the
+    // newest entry that lost the depth comparison.
+    static const int BUCKET_SIZE = 4;
+    struct alignas(64) Bucket {
+        TTEntry entries[BUCKET_SIZE];
+    };
+
+    std::unique_ptr<Bucket[]> buckets;
+    std::size_t bucketMask;
+    std::uint8_t generation;
+
+    const TTEntry* findEntry(std::uint64_t key, std::uint64_t& data) const;
+
+    static int valueToTT(int value, int ply);
+    static int valueFromTT(int value, int ply);
+
+    static std::uint64_t pack(const Move& move, int value, int depth, int type, int generation);
+    static Move unpackMove(std::uint64_t data);
+    static int unpackValue(std::uint64_t data) { return static_cast<std::int16_t>(data >> 16); }
+    static int unpackDepth(std::uint64_t data) { return static_cast<int>((data >> 32) & 0xFF) - 1; }
+    static int unpackType(std::uint64_t data) { return static_cast<int>((data >> 40) & 0x3); }
+    static int unpackGeneration(std::uint64_t data) { return static_cast<int>((data >> 42) & 0x3F); }
+};
@@ -1,9 +1,15 @@
 #include "uci.h"
+#include "perft.h"
+#include "attacks.h"
+#include "nnue.h"
+#include "nnue_kernels.h"
+#include <cstdlib>
 #include <iostream>
 #include <string>
 #include <sstream>
 #include <limits>
 #include <vector>
+#include <algorithm>
 
 UCI::UCI() : currentBoard(), searchEngine(), timeManager() {
     std::cout << "Advanced Chess Engine UCI" << std::endl;
@@ -48,7 +54,23 @@ void UCI::processCommand(const std::string& command) {
 void UCI::handleUciCommand() {
     sendUciResponse("id name Chess-E");
     sendUciResponse("id author Zyleree");
+    sendUciResponse("option name Hash type spin default " + std::to_string(TranspositionTable::DEFAULT_SIZE_MB) +
+                    " min 1 max " + std::to_string(TranspositionTable::MAX_SIZE_MB));
+    sendUciResponse("option name Threads type spin default 1 min 1 max " + std::to_string(Search::MAX_THREADS));
     sendUciResponse("option name AggressiveMode type check default false"); 
+    std::string backends;
+    for (int i = 0; i < Attacks::BACKEND_COUNT; ++i) {
+        Attacks::SliderBackend backend = static_cast<Attacks::SliderBackend>(i);
+        if (Attacks::backendSupported(backend)) {
+            backends += std::string(" var ") + Attacks::backendName(backend);
+        }
+    }
+    sendUciResponse(std::string("option name SliderBackend type combo default ") +
+                    Attacks::backendName(Attacks::sliderBackend) + backends);
+    sendUciResponse("option name LazyEvalMargin type spin default " + std::to_string(Evaluation::DEFAULT_LAZY_MARGIN) +
+                    " min 0 max 2000");
+    sendUciResponse("option name UseNNUE type check default false");
+    sendUciResponse(std::string("option name EvalFile type string default ") + NNUE::BUILTIN_NETWORK);
     sendUciResponse("uciok");
 }
 
@@ -59,6 +81,7 @@ void UCI::handleIsReadyCommand() {
 void UCI::handleUciNewGameCommand() {
     currentBoard.initializeStandardSetup();
     gameHistory.clear(); 
+    searchEngine.newGame();
 }
 
 void UCI::handlePositionCommand(std::stringstream& ss) {
@@ -76,11 +99,10 @@ void UCI::handlePositionCommand(std::stringstream& ss) {
     ss >> token;
     if (token == "moves") {
         while (ss >> token) {
-            Move move = parseUCIMove(token);
-            if (move.startRow != -1) {
+            Move move = parseUCIMove(currentBoard, token);
+            if (move.isValid()) {
                 gameHistory.push_back(currentBoard);
-                currentBoard.movePiece(move.startRow, move.startCol, move.endRow, move.endCol);
-                currentBoard.switchTurn();
+                currentBoard.makeMove(move);
             }
         }
     }
@@ -93,7 +115,13 @@ void UCI::handleGoCommand(std::stringstream& ss) {
     int wtime = -1, btime = -1, winc = 0, binc = 0; 
 
     while (ss >> token) {
-        if (token == "depth") {
+        if (token == "perft") {
+            int perftDepth = 1;
+            ss >> perftDepth;
+            Perft perft(0, searchEngine.getThreads());
+            perft.divide(currentBoard, perftDepth, std::cout);
+            return;
+        } else if (token == "depth") {
             ss >> depth;
         } else if (token == "movetime") {
             int moveTimeMs;
@@ -118,9 +146,10 @@ void UCI::handleGoCommand(std::stringstream& ss) {
 
     Move bestMove = searchEngine.findBestMove(currentBoard, depth, timeLimit);
     sendUciResponse("bestmove " + moveToString(bestMove));
-    gameHistory.push_back(currentBoard);
-    currentBoard.movePiece(bestMove.startRow, bestMove.startCol, bestMove.endRow, bestMove.endCol);
-    currentBoard.switchTurn();
+    if (bestMove.isValid()) {
+        gameHistory.push_back(currentBoard);
+        currentBoard.makeMove(bestMove);
+    }
 }
 
 void UCI::handleStopCommand() {
@@ -135,14 +164,47 @@ void UCI::handleSetOptionCommand(std::stringstream& ss) {
     while (ss >> token && token != "value") {
         name += token + " ";
     }
+    if (name.empty()) return;
     name.pop_back(); 
-    ss >> token >> valueStr; 
+    // The value is the rest of the line, so it may contain spaces.
+    std::getline(ss >> std::ws, valueStr);
 
 
     if (name == "AggressiveMode") {
         bool value = (valueStr == "true");
         timeManager.setAggressiveMode(value);
         std::cout << "Set option AggressiveMode to " << value << std::endl;
+    } else if (name == "Hash") {
+        int megabytes = std::atoi(valueStr.c_str());
+        if (megabytes > 0) {
+            searchEngine.setHashSize(static_cast<std::size_t>(megabytes));
+        }
+    } else if (name == "Threads") {
+        int threads = std::atoi(valueStr.c_str());
+        if (threads > 0) {
+            searchEngine.setThreads(threads);
+        }
+    } else if (name == "SliderBackend") {
+        Attacks::SliderBackend backend;
+        if (!Attacks::parseBackend(valueStr, backend) || !Attacks::setBackend(backend)) {
+            sendUciResponse("info string SliderBackend " + valueStr + " is not available on this CPU");
+        }
+    } else if (name == "LazyEvalMargin") {
+        Evaluation::setLazyMargin(std::atoi(valueStr.c_str()));
+    } else if (name == "UseNNUE") {
+        NNUE::setEnabled(valueStr == "true");
+        if (NNUE::isEnabled()) {
+            sendUciResponse("info string NNUE evaluation using " + NNUE::networkName() + " (" +
+                            NNUE::simdName(NNUE::simdLevel()) + ")");
+        }
+    } else if (name == "EvalFile") {
+        if (valueStr.empty() || valueStr == NNUE::BUILTIN_NETWORK) {
+            NNUE::useBuiltinNetwork();
+        } else if (!NNUE::loadNetwork(valueStr)) {
+            sendUciResponse("info string EvalFile " + valueStr + " could not be loaded");
+            return;
+        }
+        sendUciResponse("info string Loaded network " + NNUE::networkName());
     } 
 }
 
@@ -157,23 +219,10 @@ void UCI::sendUciResponse(const std::string& response) {
 }
 
 std::string UCI::moveToString(const Move& move) const {
-    if (move.startRow == -1) return "nomove";
-    char startFile = 'a' + move.startCol;
-    int startRank = 8 - move.startRow;
-    char endFile = 'a' + move.endCol;
-    int endRank = 8 - move.endRow;
-    std::stringstream ss;
-    ss << startFile << startRank << endFile << endRank;
-    return ss.str();
+    if (!move.isValid()) return "nomove";
+    return move.toString();
 }
 
-Move UCI::parseUCIMove(const std::string& moveStr) const {
-    if (moveStr.length() == 4 || moveStr.length() == 5) {
-        int startCol = moveStr[0] - 'a';
-        int startRow = 8 - (moveStr[1] - '0');
-        int endCol = moveStr[2] - 'a';
-        int endRow = 8 - (moveStr[3] - '0');
-        return Move(startRow, startCol, endRow, endCol);
-    }
-    return Move(-1, -1, -1, -1);
+Move UCI::parseUCIMove(const Board& board, const std::string& moveStr) const {
+    return MoveGenerator().parseMove(board, moveStr);
 }
\ No newline at end of file
@@ -33,7 +33,7 @@ private:
 
     void sendUciResponse(const std::string& response);
     std::string moveToString(const Move& move) const;
-    Move parseUCIMove(const std::string& moveStr) const;  
+    Move parseUCIMove(const Board& board, const std::string& moveStr) const;  
 };
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Zobrist {
+
+struct Keys {
+    std::uint64_t pieces[2][6][64];
+    std::uint64_t castling[16];
+    std::uint64_t enPassantFile[8];
+    std::uint64_t sideToMove;
+};
+
+// splitmix64, evaluated at compile time so the keys never depend on
+// static initialization order.
+constexpr std::uint64_t splitMix(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+constexpr Keys generateKeys() {
+    Keys keys = {};
+    std::uint64_t state = 0x43686573732D45ULL;
+    for (int color = 0; color < 2; ++color) {
+        for (int type = 0; type < 6; ++type) {
+            for (int square = 0; square < 64; ++square) {
+                keys.pieces[color][type][square] = splitMix(state);
+            }
+        }
+    }
+    // Each right gets its own key and combinations XOR them together, so a
+    // change of rights is a single XOR of old ^ new.
+    std::uint64_t rightKeys[4] = {splitMix(state), splitMix(state), splitMix(state), splitMix(state)};
+    for (int rights = 0; rights < 16; ++rights) {
+        for (int bit = 0; bit < 4; ++bit) {
+            if (rights & (1 << bit)) {
+                keys.castling[rights] ^= rightKeys[bit];
+            }
+        }
+    }
+    for (int file = 0; file < 8; ++file) {
+        keys.enPassantFile[file] = splitMix(state);
+    }
+    keys.sideToMove = splitMix(state);
+    return keys;
+}
+
+inline constexpr Keys KEYS = generateKeys();
+
+}
@@ -1,9 +1,14 @@
 #include "../src/board.h"
 #include "../src/evaluation.h"
+#include "../src/movegen.h"
+#include "../src/nnue.h"
+#include "../src/nnue_kernels.h"
 #include <iostream>
 #include <vector>
 #include <string>
 #include <chrono>
+#include <cstdio>
+#include <cstring>
 
 // Helper function to print board
 void printBoard(const Board& board) {
@@ -167,7 +172,97 @@ void runEvaluationTests() {
     std::cout << "Passed " << passedTests << " out of " << positions.size() << " tests\n";
 }
 
-int main() {
+// Positions with castling, en passant and promotions within a few plies, so
+// every kind of accumulator delta is replayed.
+const std::vector<std::string> NNUE_POSITIONS = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+};
+
+// Evaluates every node of the tree incrementally and compares the result
+// with the same position built from scratch.
+void checkIncrementalUpdates(Board& board, int depth, int& nodes, int& mismatches) {
+    Board fresh(board.toFen());
+    int incremental = NNUE::evaluate(board);
+    NNUE::Accumulator a = NNUE::accumulator(board);
+    int refreshed = NNUE::evaluate(fresh);
+    const NNUE::Accumulator& b = NNUE::accumulator(fresh);
+    if (incremental != refreshed || std::memcmp(a.values, b.values, sizeof(a.values)) != 0) {
+        if (mismatches++ == 0) {
+            std::cout << "Incremental mismatch at " << board.toFen() << ": " << incremental << " vs " << refreshed << "\n";
+        }
+    }
+    nodes++;
+
+    if (depth == 0) return;
+    for (const Move& move : MoveGenerator().generateLegalMoves(board)) {
+        board.makeMove(move);
+        checkIncrementalUpdates(board, depth - 1, nodes, mismatches);
+        board.unmakeMove();
+    }
+}
+
+bool runNnueTests() {
+    bool ok = true;
+    NNUE::setEnabled(true);
+    NNUE::useBuiltinNetwork();
+    std::cout << "Running NNUE Tests (network " << NNUE::networkName() << ")\n";
+    std::cout << "================================\n\n";
+
+    int nodes = 0, mismatches = 0;
+    for (const std::string& fen : NNUE_POSITIONS) {
+        Board board(fen);
+        checkIncrementalUpdates(board, 3, nodes, mismatches);
+    }
+    std::cout << "Incremental vs refresh: " << nodes << " nodes, " << mismatches << " mismatches\n";
+    ok = ok && mismatches == 0;
+
+    NNUE::SimdLevel defaultLevel = NNUE::simdLevel();
+    std::vector<int> reference;
+    NNUE::setSimdLevel(NNUE::SCALAR);
+    for (const std::string& fen : NNUE_POSITIONS) {
+        reference.push_back(NNUE::evaluate(Board(fen)));
+    }
+    for (int i = NNUE::SCALAR + 1; i < NNUE::SIMD_LEVEL_COUNT; ++i) {
+        NNUE::SimdLevel level = static_cast<NNUE::SimdLevel>(i);
+        if (!NNUE::setSimdLevel(level)) {
+            std::cout << "SIMD " << NNUE::simdName(level) << ": not supported, skipped\n";
+            continue;
+        }
+        bool same = true;
+        for (std::size_t j = 0; j < NNUE_POSITIONS.size(); ++j) {
+            same = same && NNUE::evaluate(Board(NNUE_POSITIONS[j])) == reference[j];
+        }
+        std::cout << "SIMD " << NNUE::simdName(level) << " vs scalar: " << (same ? "PASSED" : "FAILED") << "\n";
+        ok = ok && same;
+    }
+    NNUE::setSimdLevel(defaultLevel);
+
+    std::string path = "nnue_roundtrip.bin";
+    std::uint64_t id = NNUE::networkId();
+    bool roundtrip = NNUE::saveNetwork(path) && NNUE::loadNetwork(path) && NNUE::networkId() == id &&
+                     NNUE::evaluate(Board(NNUE_POSITIONS[1])) == reference[1];
+    std::remove(path.c_str());
+    std::cout << "Save/load roundtrip: " << (roundtrip ? "PASSED" : "FAILED") << "\n";
+    ok = ok && roundtrip;
+
+    // White is a queen up; the side to move sees it with the right sign.
+    int whiteToMove = NNUE::evaluate(Board("rnb1kbnr/pppp1ppp/8/4p3/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 1"));
+    int blackToMove = NNUE::evaluate(Board("rnb1kbnr/pppp1ppp/8/4p3/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1"));
+    bool sane = whiteToMove > 600 && blackToMove < -600;
+    std::cout << "Queen up: " << whiteToMove << " / " << blackToMove << " " << (sane ? "PASSED" : "FAILED") << "\n";
+    ok = ok && sane;
+
+    std::cout << (ok ? "All NNUE tests passed\n" : "NNUE tests FAILED\n");
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--nnue") {
+        return runNnueTests() ? 0 : 1;
+    }
     runEvaluationTests();
     return 0;
 } 
\ No newline at end of file
@@ -1,8 +1,9 @@
 #include "../src/board.h"
 #include "../src/search.h"
 #include "../src/quiescence_search.h"
-#include "../src/principal_variation_search.h"
+#include "../src/alphabeta.h"
 #include "../src/evaluation.h"
+#include "../src/see.h"
 #include <iostream>
 #include <vector>
 #include <string>
@@ -81,12 +82,12 @@ bool setPositionFromFen(Board& board, const std::string& fen) {
 }
 
 std::string formatMove(const Move& move) {
-    if (move.startRow == -1) return "none";
+    if (!move.isValid()) return "none";
     std::string result;
-    result += char('a' + move.startCol);
-    result += char('8' - move.startRow);
-    result += char('a' + move.endCol);
-    result += char('8' - move.endRow);
+    result += char('a' + move.startCol());
+    result += char('8' - move.startRow());
+    result += char('a' + move.endCol());
+    result += char('8' - move.endRow());
     return result;
 }
 
@@ -103,9 +104,6 @@ void runTacticalTests() {
     std::cout << "==============================\n\n";
 
     Search searchEngine;
-    QuiescenceSearch quiescenceSearch;
-    PrincipalVariationSearch pvsSearch;
-    AlphaBetaSearch abSearch;
     
     std::vector<TacticalTest> tests = {
         {
@@ -168,6 +166,7 @@ void runTacticalTests() {
         
         auto startTime = std::chrono::high_resolution_clock::now();
         
+        searchEngine.newGame();
         Move bestMove = searchEngine.findBestMove(board, test.depth, std::chrono::milliseconds(10000));
         
         auto endTime = std::chrono::high_resolution_clock::now();
@@ -214,6 +213,109 @@ void testQuiescenceSearch() {
     std::cout << "Search time: " << duration.count() << "ms\n\n";
 }
 
+// Mates must be scored as mates even when they fall at the horizon: the
+// quiescence search on a mated position, and a depth 1 search whose best
+// move mates.
+bool testHorizonMates() {
+    int failures = 0;
+
+    Board mated("r1bqk2r/pppp1Qpp/2n2n2/2b5/2B1P3/8/PPPP1PPP/RNB1K1NR b KQkq - 0 1");
+    int score = QuiescenceSearch().quiescence(mated, -Evaluation::INFINITY_VALUE, Evaluation::INFINITY_VALUE);
+    bool passed = score == -Evaluation::CHECKMATE_VALUE;
+    std::cout << "Quiescence on a mated position: " << score << " " << (passed ? "PASSED" : "FAILED") << "\n";
+    if (!passed) failures++;
+
+    TranspositionTable table(1);
+    AlphaBetaSearch search(table);
+    Board board("r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 0 1");
+    Move bestMove;
+    score = search.searchRoot(board, 1, Evaluation::VALUE_UNKNOWN, bestMove);
+    passed = formatMove(bestMove) == "h5f7" && score == Evaluation::CHECKMATE_VALUE - 1;
+    std::cout << "Depth 1 on Scholar's Mate: " << formatMove(bestMove) << " scored " << score << " "
+              << (passed ? "PASSED" : "FAILED") << "\n";
+    if (!passed) failures++;
+
+    return failures == 0;
+}
+
+struct ExchangeTest {
+    std::string fen;
+    std::string move;
+    int expected;
+};
+
+// Exchange values with PSQT::PIECE_VALUE (P 100, N 320, B 330, R 500, Q 900).
+bool testStaticExchange() {
+    std::vector<ExchangeTest> tests = {
+        {"1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1", "e1e5", 100},                   // undefended pawn
+        {"1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1", "d3e5", -220},         // knight for a pawn
+        {"3rk3/8/8/3p4/8/8/3R4/3RK3 w - - 0 1", "d2d5", 100},                                // rook x-rays the rook
+        {"3rk3/3r4/8/3p4/8/8/3R4/3RK3 w - - 0 1", "d2d5", -400},                             // both sides doubled
+        {"4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1", "e5d6", 100},                                  // en passant
+        {"4k3/8/2b5/3q4/4P3/8/8/4K3 w - - 0 1", "e4d5", 800},                                // pawn takes queen
+        {"rnbqkbnr/pppp1ppp/8/4p3/4P3/5Q2/PPPP1PPP/RNB1KBNR w KQkq - 0 1", "f3f7", -800},   // queen for a pawn
+        {"4k3/P7/8/8/8/8/8/4K3 w - - 0 1", "a7a8q", 800},                                    // promotion
+        {"4k3/8/8/8/8/2n5/8/R3K3 w - - 0 1", "a1a3", 0},                                     // quiet, safe square
+        {"4k3/8/8/1n6/8/8/8/R3K3 w - - 0 1", "a1a3", -500},                                  // quiet, hangs the rook
+    };
+
+    int failures = 0;
+    MoveGenerator generator;
+    for (const ExchangeTest& test : tests) {
+        Board board(test.fen);
+        Move move = generator.parseMove(board, test.move);
+        int value = SEE::evaluate(board, move);
+        bool passed = move.isValid() && value == test.expected;
+        std::cout << "SEE " << test.move << " in " << test.fen << ": " << value << " (expected " << test.expected
+                  << ") " << (passed ? "PASSED" : "FAILED") << "\n";
+        if (!passed) failures++;
+    }
+    return failures == 0;
+}
+
+// Several threads must still find the right moves, and the helpers' private
+// boards must leave the caller's board exactly as it was. The helpers have no
+// depth limit, so on a search long enough for them to get going they must
+// have completed an iteration and been stopped by the main thread before
+// findBestMove returned, well inside the time limit.
+bool testLazySmp() {
+    std::vector<TacticalTest> tests = {
+        {"Back Rank Mate", "6k1/5ppp/8/8/8/8/5PPP/R5K1 w - - 0 1", "a1a8", 6},
+        {"Scholar's Mate", "r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 0 1", "h5f7", 6},
+        {"Simple Capture", "r1bqkbnr/ppp2ppp/2n5/3pp3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 0 1", "e4d5", 6},
+    };
+    const std::chrono::milliseconds timeLimit(60000);
+
+    Search searchEngine;
+    searchEngine.setThreads(4);
+    int failures = 0;
+    for (const TacticalTest& test : tests) {
+        Board board(test.fen);
+        std::string before = board.toFen();
+        searchEngine.newGame();
+        Move bestMove = searchEngine.findBestMove(board, test.depth, timeLimit);
+        bool passed = formatMove(bestMove) == test.expectedBestMove && board.toFen() == before;
+        std::cout << test.name << " with " << searchEngine.getThreads() << " threads: " << formatMove(bestMove)
+                  << " (expected " << test.expectedBestMove << ") " << (passed ? "PASSED" : "FAILED") << "\n";
+        if (!passed) failures++;
+    }
+
+    Board board("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    auto startTime = std::chrono::steady_clock::now();
+    searchEngine.findBestMove(board, 9, timeLimit);
+    auto elapsed = std::chrono::steady_clock::now() - startTime;
+    bool stopped = !searchEngine.helpersSearching() && elapsed < timeLimit / 2;
+    for (int i = 0; i + 1 < searchEngine.getThreads(); ++i) {
+        IterativeDeepening::SearchInfo info = searchEngine.getHelperInfo(i);
+        bool passed = stopped && info.depthSearched > 0 && info.nodesEvaluated > 0;
+        std::cout << "Helper " << i + 1 << ": depth " << info.depthSearched << ", " << info.nodesEvaluated
+                  << " nodes, " << (stopped ? "stopped" : "still running") << " " << (passed ? "PASSED" : "FAILED")
+                  << "\n";
+        if (!passed) failures++;
+    }
+    return failures == 0;
+}
+
 void benchmarkSearchAlgorithms() {
     std::cout << "Benchmarking Search Algorithms\n";
     std::cout << "============================\n\n";
@@ -242,7 +344,7 @@ void benchmarkSearchAlgorithms() {
             auto startTime = std::chrono::high_resolution_clock::now();
             Move bestMove = search1.findBestMove(board, depth, std::chrono::milliseconds(60000));
             Evaluation eval;
-            board.movePiece(bestMove.startRow, bestMove.startCol, bestMove.endRow, bestMove.endCol);
+            board.movePiece(bestMove.startRow(), bestMove.startCol(), bestMove.endRow(), bestMove.endCol());
             int score = eval.evaluate(board);
             auto endTime = std::chrono::high_resolution_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
@@ -261,7 +363,7 @@ void benchmarkSearchAlgorithms() {
             auto startTime = std::chrono::high_resolution_clock::now();
             Move bestMove = search2.findBestMove(board, depth, std::chrono::milliseconds(60000));
             Evaluation eval;
-            board.movePiece(bestMove.startRow, bestMove.startCol, bestMove.endRow, bestMove.endCol);
+            board.movePiece(bestMove.startRow(), bestMove.startCol(), bestMove.endRow(), bestMove.endCol());
             int score = eval.evaluate(board);
             auto endTime = std::chrono::high_resolution_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
@@ -280,7 +382,17 @@ void benchmarkSearchAlgorithms() {
     }
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--see") {
+        return testStaticExchange() ? 0 : 1;
+    }
+    if (argc > 1 && std::string(argv[1]) == "--mate") {
+        return testHorizonMates() ? 0 : 1;
+    }
+    if (argc > 1 && std::string(argv[1]) == "--smp") {
+        return testLazySmp() ? 0 : 1;
+    }
+
     std::cout << "Chess Engine Search Tests\n";
     std::cout << "========================\n\n";
     